@@ -2,10 +2,10 @@
 // Created by natem on 4/4/2025.
 //
 
-#include <cassert>
 #include <iostream>
 #include "AST.h"
-#include <stack>
+#include "astPrinter.h"
+#include "../tokenize/tokenize.h"
 using namespace std;
 
 
@@ -16,18 +16,40 @@ using namespace std;
 AST::AST(CST *cst, symbolTable * ST)
 {
     // initialize the iterator node to the root of the CST
-    // and insertion pointers
-    node * iter = cst->root();
-    ASTnode * parent = nullptr, *child = nullptr, * _node = parent;
+    cstIter iter = cst->root();
     this->ST = ST;
 
-    while (iter)
+    addDeclarations(iter, NO_NODE);
+}
+
+
+/**
+ * Constructor for an empty AST, a CST that is parsing adds each declaration
+ * to it as soon as it is parsed (see CST::CST)
+ */
+AST::AST(symbolTable * ST)
+{
+    this->ST = ST;
+}
+
+
+/***
+ * This adds the top level declarations (functions, procedures and global
+ * variables) of a CST to the end of the AST
+ * @param iter the first node of the declarations, it is left on the node the
+ * AST stopped at
+ * @param end index of the node to stop at (NO_NODE for the end of the CST)
+ */
+void AST::addDeclarations(cstIter& iter, uint32_t end)
+{
+    while (iter && iter.index() != end)
     {
-        // variable used to check if insertions are for a sibling/child
+        // variable used to check if the declaration starts a new line
         int origLineNum = lineNum;
+        ASTnode * child = nullptr;
 
         // check if the current node is for a function/procedure
-        if (match(iter, "function") || (match(iter, "procedure")))
+        if (match(iter, KW_FUNCTION) || (match(iter, KW_PROCEDURE)))
         {
             child = parseFunctionDeclaration(iter);
         }
@@ -42,120 +64,54 @@ AST::AST(CST *cst, symbolTable * ST)
              nextNode(iter);
              printf("INVALID STATEMENT ENCOUNTERED\n");
         }
-        // after creating the new child node, insert it into the AST
-        insert(parent, _node, child, origLineNum);
+        // after creating the new child node, add it to the AST (the first one keeps
+        // its flag too, see append)
+        if (child)
+        {
+            markLine(child, origLineNum);
+            _declarations.push_back(child);
+        }
     }
-    // set the head to the parent node
-    head = parent;
 }
 
 
 /***
- * Destructor
+ * This adds the declarations of another AST after this one's without copying them (a
+ * session's AST for the whole program is put together from the ASTs of its pieces)
+ * @param other the AST to be linked
  */
-AST::~AST()
+void AST::append(AST * other)
 {
-    ASTnode * iter = head;
-    while (iter)
-    {
-        ASTnode * temp = iter;
-        if (iter->sibling())
-            iter = iter->sibling();
-        else
-            iter = iter->child();
-        delete temp;
-    }
+    _declarations.insert(_declarations.end(), other->_declarations.begin(), other->_declarations.end());
 }
 
 
-
 /***
- * This is the main insertion function for the AST
- * @param parent the parent/root node
- * @param _node the current place in the AST
- * @param child the node to be inserted
- * @param origLineNum this is used to see if the line number
- * had changed during the creation of the child node
+ * This empties an AST that only links other ASTs' nodes without deleting them (see append)
  */
-void AST::insert(ASTnode *& parent,  ASTnode *& _node, ASTnode *& child, int origLineNum)
+void AST::release()
 {
-    // ensure that the child node is not null
-    if (child) {
-        // if you stayed on the same line, insert as a sibling
-        if (origLineNum == lineNum)
-            insertSibling(parent, _node, child);
-        // line number changed, insert as a child of the AST
-        else
-            insertChild(parent, _node, child);
-    }
+    _declarations.clear();
 }
 
 
 /***
- * This function insert a node as a child of a current AST structure
- *
- * @param parent parent/root node of the structure
- * @param curNode the last/end node in the structure
- * @param _node the root node to be inserted
+ * Destructor (the arena frees every node at once, the declarations another AST's are
+ * only linked, see append)
  */
-void AST::insertChild(ASTnode *& parent, ASTnode *& curNode, ASTnode *& _node )
-{
-    // check if the insertion node is null
-    if (!_node)
-        return;
-
-    // check if the tree is empty
-    if (!parent)
-    {
-        parent = _node;
-        curNode = getLastNode(_node);
-    }
-    else
-    {
-        // tree is not empty, set the current node's child to the
-        // new node and set current node to the last node of the
-        // child node
-        assert(curNode);
-        curNode->child(_node);
-        curNode = getLastNode(_node);
-    }
-    // set the child node ptr to null
-    _node = nullptr;
-}
-
+AST::~AST() = default;
 
 
 /***
- * This is used to insert a new node as a sibling of a current
- * AST structure
- *
- * @param parent parent/root node of the structure
- * @param curNode the last/end node in the structure
- * @param _node the root node to be inserted
+ * This marks a node that was parsed over more lines of the CST than the structure it
+ * is put in so far, it is output on a new line (see astPrinter)
+ * @param child the node (nothing is done if it is null)
+ * @param origLineNum the line number before the node was parsed
  */
-void AST::insertSibling(ASTnode *& parent, ASTnode *& curNode, ASTnode *& _node )
+void AST::markLine(ASTnode * child, int origLineNum) const
 {
-    // ensure the insertion node is not null
-    if (!_node)
-        return;
-
-    // check if the tree is currently empty
-    if (!parent)
-    {
-        parent = _node;
-        curNode = getLastNode(_node);
-    }
-    else
-    {
-        // tree is not empty so set the sibling of the current node
-        // to the child
-        // then set current node to the last node of the sibling
-        assert(curNode);
-        curNode->sibling(_node);
-        curNode = getLastNode(_node);
-    }
-    // set the child node ptr to null
-    _node = nullptr;
+    if (child)
+        child->newLine = origLineNum != lineNum;
 }
 
 
@@ -165,7 +121,7 @@ void AST::insertSibling(ASTnode *& parent, ASTnode *& curNode, ASTnode *& _node
  * @param iter the pointer to the current place
  * in the CST
  */
-void AST::nextNode(node *& iter)
+void AST::nextNode(cstIter& iter)
 {
     // check if the given pointer is null
     if (iter) {
@@ -190,13 +146,13 @@ void AST::nextNode(node *& iter)
  * @param iter the node pointer
  * @return true if it is, false if not
  */
-bool AST::isDatatype(node * iter)
+bool AST::isDatatype(cstIter iter)
 {
     // ensure the node is not null, so you do not try to call
     // a member function on a null pointer
     if (iter)
     {
-        if (iter->content() == "int" || iter->content() == "char" || iter->content() == "bool")
+        if (match(iter, KW_INT) || match(iter, KW_CHAR) || match(iter, KW_BOOL))
             return true;
     }
     return false;
@@ -212,10 +168,10 @@ bool AST::isDatatype(node * iter)
  * @return true if the node contains that set string,
  * false if not
  */
-bool AST::match(node * iter, const string& str)
+bool AST::match(cstIter iter, internedString str)
 {
     // if the node is not null and holds the string value
-    if (iter && iter->content() == str)
+    if (iter && iter->name() == str)
     {
         return true;
     }
@@ -223,60 +179,85 @@ bool AST::match(node * iter, const string& str)
 }
 
 
+/***
+ * This function safely checks if a given node holds a set
+ * special token (compared by interned ID)
+ *
+ * @param iter the current node in the CST
+ * @param kind the special token
+ * @return true if the node holds the special token, false if not
+ */
+bool AST::match(cstIter iter, tokenKind kind)
+{
+    return iter && punctuatorKind(iter->name().id()) == kind;
+}
+
+
+/***
+ * This function safely checks if a given node holds a set
+ * keyword (compared by interned ID)
+ *
+ * @param iter the current node in the CST
+ * @param word the keyword
+ * @return true if the node holds the keyword, false if not
+ */
+bool AST::match(cstIter iter, keywordKind word)
+{
+    return iter && iter->name().id() == keywordId(word);
+}
+
+
 /***
  * This function parses a variable declaration statement
  *
  * @param iter the current node in the CST
- * @return the root of the AST structure
+ * @return the declaration
  */
-ASTnode * AST::parseVarDeclaration(node *& iter)
+declarationNode * AST::parseVarDeclaration(cstIter& iter)
 {
-    // initialize the line number variable (for insertions)
-    int origLineNum = lineNum;
     // iterate past the datatype to the name of the variable
     iter = iter->sibling();
 
-    // create a new Declaration AST node with a pointer to the variable's symbol table node
-    auto * parent = new ASTnode(DECLARATION, ST->retrieveNode(iter->content(), iter->scope()));
-
-    ASTnode * child = nullptr, * _node = parent;
+    // keep a pointer to the variable's symbol table node
+    auto * declaration = make<declarationNode>();
+    vector<stNode *> symbols = {ST->retrieveNode(iter->name(), iter->scope())};
     iter = iter->sibling();
 
     // if you have a variable that is an array, parse past the brackets
-    if (match(iter, "["))
+    if (match(iter, TK_L_BRACKET))
     {
         iter = iter->sibling(); // iterate past first bracket
-        if (!match(iter, "]")) // if there is a size variable
+        if (!match(iter, TK_R_BRACKET)) // if there is a size variable
             iter = iter->sibling();
         iter = iter->sibling(); // pass ending bracket
     }
 
     // check if there are multiple declarations
-    if (match(iter, ","))
+    if (match(iter, TK_COMMA))
     {
         iter = iter->sibling();
-        while (iter && !match(iter, ";"))
+        while (iter && !match(iter, TK_SEMICOLON))
         {
-            lineNum++; // use if you want multiple declarations on the same line to appear as children
-            if (!match(iter, ",")) {
-                if (match(iter, "["))
+            lineNum++; // multiple declarations on the same line are output on lines of their own
+            if (!match(iter, TK_COMMA)) {
+                if (match(iter, TK_L_BRACKET))
                 {
                     iter = iter->sibling(); // iterate past the first bracket
                     iter = iter->sibling(); // iterate past the index variable
                     iter = iter->sibling(); // iterate past the end bracket
-                    if (match(iter, ";"))
+                    if (match(iter, TK_SEMICOLON))
                         break;
                 }
-                child = new ASTnode(DECLARATION, ST->retrieveNode(iter->content(), iter->scope()));
-                insert(parent, _node, child, origLineNum);
+                symbols.push_back(ST->retrieveNode(iter->name(), iter->scope()));
             }
             iter = iter->sibling();
         }
     }
 
+    declaration->symbols = keep(symbols);
     // iterate past ";"
     nextNode(iter);
-    return parent;
+    return declaration;
 
 }
 
@@ -285,33 +266,30 @@ ASTnode * AST::parseVarDeclaration(node *& iter)
  * This function parses a function/procedure declaration
  *
  * @param iter the current node in the CST
- * @return the AST structure of the function/procedure
+ * @return the function/procedure
  */
-ASTnode * AST::parseFunctionDeclaration(node *& iter)
+functionNode * AST::parseFunctionDeclaration(cstIter& iter)
 {
-    // set the origLineNum for future insertion
+    // set the origLineNum for the body
     int originalLineNum = lineNum;
     int scope = iter->scope();
 
     // check if function
-    if (iter->content() == "function")
+    if (match(iter, KW_FUNCTION))
         iter = iter->sibling(); // iterate to return type
     iter = iter->sibling(); // iterate to name
 
-    string funcName = iter->content();
-    auto * declarationNode = new ASTnode(DECLARATION, ST->retrieveNode(funcName, scope));
-    auto * _node = declarationNode;
+    stNode * symbol = ST->retrieveNode(iter->name(), scope);
 
     // iterate past the function parameters
-    parseToGivenChar(")", iter);
+    parseToGivenChar(TK_R_PAREN, iter);
     // iterate past ending ")"
     nextNode(iter);
 
-    // create a child of the contents of the function/procedure
-    auto * child = parseBlockStatement(iter);
-    // insert it
-    insert(declarationNode, _node, child, originalLineNum);
-    return declarationNode;
+    // parse the contents of the function/procedure
+    blockNode * body = parseBlockStatement(iter);
+    markLine(body, originalLineNum);
+    return make<functionNode>(symbol, body);
 }
 
 
@@ -320,43 +298,41 @@ ASTnode * AST::parseFunctionDeclaration(node *& iter)
  * and functions/procedures
  *
  * @param iter the current node in the CST
- * @return the root node of the block statement in an
- * AST structure
+ * @return the block statement
  */
-ASTnode* AST::parseBlockStatement( node *& iter) {
+blockNode * AST::parseBlockStatement( cstIter& iter) {
 
-    // set initial variables and parent node
+    // set initial variables and the block
     int origLineNum = lineNum;
-    auto * parent = new ASTnode(BEGIN_BLOCK, nullptr);
-    auto * _node = parent;
+    auto * block = make<blockNode>();
     nextNode(iter);
 
     // parse the statements contained in the block
-    ASTnode* body = parseCompoundStatement(iter);
-    insert(parent, _node, body, origLineNum);
-
-    // add the ending bracket
-    auto * child = new ASTnode(END_BLOCK, nullptr);
-
-    // insert the end bracket and iterate to the next node
-    insert(parent, _node, child, origLineNum);
+    vector<ASTnode *> statements;
+    parseCompoundStatement(iter, statements);
+    if (!statements.empty())
+        markLine(statements.front(), origLineNum);
+    block->statements = keep(statements);
+
+    // the ending bracket, then iterate to the next node
+    block->endNewLine = origLineNum != lineNum;
     nextNode(iter);
 
-    return parent;
+    return block;
 }
 
 
 /***
  * This parses to a set char from a given node
  *
- * @param character the character to parse to
+ * @param character the special token to parse to
  * @param iter the current node in the CST
  */
-void AST::parseToGivenChar(const string& character, node *& iter)
+void AST::parseToGivenChar(tokenKind character, cstIter& iter)
 {
     if (iter)
     {
-        while (iter && iter->content() != character)
+        while (iter && !match(iter, character))
         {
             if (iter->sibling())
                 iter = iter->sibling();
@@ -375,113 +351,155 @@ void AST::parseToGivenChar(const string& character, node *& iter)
  * This function parses a compound statement
  *
  * @param iter current CST node
- * @return the root node of the AST structured
- * compound statement
+ * @param statements the statements are added to it (the caller marks the
+ * first one's line)
  */
-ASTnode* AST::parseCompoundStatement( node *& iter ) {
+void AST::parseCompoundStatement(cstIter& iter, vector<ASTnode *>& statements) {
 
     int origLineNum = lineNum;
-    ASTnode * parent = nullptr;
-    ASTnode * _node = parent;
-    ASTnode * child = nullptr;
 
     // while you do not encounter the ending bracket
     // parse the inside statements
-    while (iter && iter->content()!= "}")
+    while (iter && !match(iter, TK_R_BRACE))
     {
-        // parse the current statement and insert it
-        child = parseStatement(iter);
-        insert(parent, _node, child, origLineNum);
+        // parse the current statement and add it
+        ASTnode * child = parseStatement(iter);
+        if (child)
+        {
+            markLine(child, origLineNum);
+            statements.push_back(child);
+        }
         // parse the semicolon if you are currently at one
-        if (iter && iter->content() == ";")
+        if (match(iter, TK_SEMICOLON))
         {
             nextNode(iter);
         }
     }
-    return parent;
 }
 
 
 /***
- * This parses an AST structure and returns the
- * last node
+ * This function parses a return statement
  *
- * @param root the root node of the structure
- * @return the last node in the structure
+ * @param iter the current node in the CST
+ * @return the return statement
  */
-ASTnode* AST::getLastNode(ASTnode * root) {
-
-    if (!root)
-        return nullptr;
+returnNode * AST::parseReturnStatement(cstIter& iter)
+{
+    // set the origLineNum for safety if return statement
+    // takes multiple lines
+    int origLineNum = lineNum;
+    auto * statement = make<returnNode>();
+    iter = iter->sibling(); // iterate to the first node of the return expression
 
-    auto * iter = root;
-    while (iter) {
+    statement->value = parseExpression(iter);
+    markLine(statement->value, origLineNum);
+    nextNode(iter); // iterate past the semicolon
+    return statement;
+}
 
-        while (iter->sibling())
-            iter = iter->sibling();
 
-        if (iter->child()) {
-            iter = iter->child();
+/***
+ * This replaces the escape sequences of a char or string with what they stand for
+ * @param text the text as it is written
+ * @return the decoded text
+ */
+static string decodeEscapes(string_view text)
+{
+    string decoded;
+    decoded.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (text[i] != '\\' || i + 1 == text.size())
+        {
+            decoded += text[i];
+            continue;
         }
-        else {
-            break;
+        switch (text[++i])
+        {
+            case 'n': decoded += '\n'; break;
+            case 't': decoded += '\t'; break;
+            case 'r': decoded += '\r'; break;
+            case '0': decoded += '\0'; break;
+            case 'a': decoded += '\a'; break;
+            case 'b': decoded += '\b'; break;
+            case 'f': decoded += '\f'; break;
+            case 'v': decoded += '\v'; break;
+            case 'x':
+            {
+                int value = 0;
+                while (i + 1 < text.size() && isxdigit((unsigned char) text[i + 1]))
+                {
+                    char digit = text[++i];
+                    value = value * 16 + (isdigit((unsigned char) digit) ? digit - '0' : tolower(digit) - 'a' + 10);
+                }
+                decoded += (char) value;
+                break;
+            }
+            // \\, \' and \" (and anything else) stand for the character itself
+            default: decoded += text[i];
         }
     }
-    return iter;
+    return decoded;
 }
 
 
 /***
- * This function parses a return statement
- *
- * @param iter the current node in the CST
- * @return root node of the created structure of the
- * return statement
+ * This copies text into the arena
+ * @param text the text
+ * @return the copy (it lasts as long as the AST)
  */
-ASTnode * AST::parseReturnStatement(node *& iter)
+string_view AST::keep(string_view text)
 {
-    // set the origLineNum for safety if return statement
-    // takes multiple lines
-    int origLineNum = lineNum;
-    auto * parent = new ASTnode("RETURN", nullptr);
-    auto * _node = parent;
-    iter = iter->sibling(); // iterate to the first node of the return expression
+    if (text.empty())
+        return {};
+    auto * copy = (char *) nodes.allocate(text.size(), 1);
+    text.copy(copy, text.size());
+    return {copy, text.size()};
+}
 
-    // convert the return expression to post and insert it
-    auto * child = convertToPostFix(iter);
-    insert(parent, _node, child, origLineNum);
-    nextNode(iter); // iterate past the semicolon
-    return parent;
+
+/***
+ * This creates the literal of a char or string, its text is copied into the arena (a
+ * literal is not interned, the CST's copy goes when it drops the node)
+ * @param quote the quote it is in
+ * @param text the text between the quotes
+ * @return the literal
+ */
+literalNode * AST::quotedLiteral(tokenKind quote, internedString text)
+{
+    auto * literal = make<literalNode>(quote == TK_SINGLE_QUOTE ? LK_CHAR : LK_STRING,
+                                       internedString::literal(keep(text.view())));
+    literal->quote = quote;
+    literal->decoded = keep(decodeEscapes(text.view()));
+    if (literal->type == LK_CHAR && !literal->decoded.empty())
+        literal->value = (unsigned char) literal->decoded[0];
+    return literal;
 }
 
 
 /***
  * Parse a double quote string (very similar to single quote string)
  *
- * @param iter current CST node
- * @return AST structure of the string
+ * @param iter current CST node, it is left on the ending quote
+ * @return the char or string
  */
-ASTnode * AST::parseString(node *& iter)
+literalNode * AST::parseString(cstIter& iter)
 {
-    int origLineNum = lineNum;
-    auto * parent = new ASTnode(iter->content(), nullptr); // catch initial quote
-    auto * _node = parent;
-    ASTnode * child = nullptr;
-    iter = iter->sibling();
+    tokenKind quote = punctuatorKind(iter->name().id()); // catch initial quote
+    internedString text;
 
     // get the inside string if it exists
-    if (!match(iter, "\"") && !match(iter, "\'"))
+    if (iter->sibling() && iter->sibling()->kind() == TK_STRING)
     {
-        child = new ASTnode(iter->content(), nullptr);
-        insert(parent, _node, child, origLineNum);
         iter = iter->sibling();
+        text = iter->name();
     }
 
     // get the ending quote
-    child = new ASTnode(iter->content(), nullptr);
-    insert(parent, _node, child, origLineNum);
-    iter = iter->sibling();
-    return parent;
+    if (iter->sibling())
+        iter = iter->sibling();
+    return quotedLiteral(quote, text);
 
 }
 
@@ -489,40 +507,27 @@ ASTnode * AST::parseString(node *& iter)
 /***
  * This parses a printf statement
  * @param iter current CST node
- * @return AST structure of the statement
+ * @return the printf statement
  */
-ASTnode * AST::parsePrintfStatement(node *& iter)
+printfNode * AST::parsePrintfStatement(cstIter& iter)
 {
-    // initialize line flag and parent node
-    int origLineNum = lineNum;
-    auto * parent = new ASTnode("printf", nullptr);
-    auto * _node = parent;
-    ASTnode * child = nullptr;
+    auto * statement = make<printfNode>();
 
     iter = iter->sibling(); // iterate to (
     iter = iter->sibling(); // iterate to quote
     iter = iter->sibling(); // iterate past quote
 
-    child = new ASTnode(iter->content(), nullptr); // catch string
-    insert(parent, _node, child, origLineNum);
+    statement->format = quotedLiteral(TK_DOUBLE_QUOTE, iter->name()); // catch string
     iter = iter->sibling(); // iterate to end quote
     iter = iter->sibling(); // iterate past
 
-    // catch variables after the string if they exist
-    while (iter && iter->content() != ")")
-    {
-        // add non-comma nodes to the structure
-        if (!match(iter, ","))
-        {
-            child = new ASTnode(iter->content(), nullptr);
-            insert(parent, _node, child, origLineNum);
-        }
-        iter = iter->sibling();
-
-    }
+    // catch the expressions after the string if they exist
+    vector<ASTnode *> args;
+    parseArguments(iter, args);
+    statement->args = keep(args);
     // iterate past )
     nextNode(iter);
-    return parent;
+    return statement;
 
 }
 
@@ -532,33 +537,33 @@ ASTnode * AST::parsePrintfStatement(node *& iter)
  * needs to be parses
  *
  * @param iter current CST node
- * @return AST structure of the statement
+ * @return the statement
  */
-ASTnode* AST::parseStatement(node *& iter) {
+ASTnode* AST::parseStatement(cstIter& iter) {
 
     // conditional
-    if (match(iter, "if"))
+    if (match(iter, KW_IF))
     {
         return parseSelectionStatement(iter);
     }
     // block statement
-    else if (match(iter, "{"))
+    else if (match(iter, TK_L_BRACE))
     {
         return parseBlockStatement(iter);
     }
     // for/while loop
-    else if (match(iter,  "while") ||
-             match(iter,  "for"))
+    else if (match(iter, KW_WHILE) ||
+             match(iter, KW_FOR))
     {
         return parseIterationStatement(iter);
     }
     // return statement
-    else if (match(iter,  "return"))
+    else if (match(iter, KW_RETURN))
     {
         return parseReturnStatement(iter);
     }
     // printf statement
-    else if (match(iter,  "printf")) {
+    else if (match(iter, KW_PRINTF)) {
         return parsePrintfStatement(iter);
     }
     // variable declaration
@@ -568,9 +573,9 @@ ASTnode* AST::parseStatement(node *& iter) {
     // other identifier
     else  {
 
-        node * peek = iter->sibling();
+        cstIter peek = iter->sibling();
         // check if it is an assignment statement
-        if (match(peek, "=") || match(peek, "["))
+        if (match(peek, TK_ASSIGNMENT_OPERATOR) || match(peek, TK_L_BRACKET))
             return parseAssignmentStatement(iter);
         // not assignment, so it must be a user function call
         else
@@ -583,85 +588,72 @@ ASTnode* AST::parseStatement(node *& iter) {
 /***
  * This parses "for" and "while" statements
  * @param iter current CST node
- * @return AST structure of the entire statement
+ * @return the loop
  */
-ASTnode * AST::parseIterationStatement(node *& iter)
+ASTnode * AST::parseIterationStatement(cstIter& iter)
 {
-    // set line number flag and node pointers
+    // set line number flag
     int origLineNum = lineNum;
-    ASTnode * parent = nullptr, * _node = parent, * child = nullptr;
 
     // check if you have encountered a while loop
-    if (match(iter, "while")) {
-        // catch initial node
-        parent = new ASTnode("while", nullptr);
-        _node = parent;
+    if (match(iter, KW_WHILE)) {
+        auto * loop = make<whileNode>();
         iter = iter->sibling();
 
-        // convert the condition to post fix
-        ASTnode* condition = convertToPostFix(iter);
-        insert(parent,_node, condition, origLineNum);
+        // parse the condition
+        loop->condition = parseCondition(iter);
+        markLine(loop->condition, origLineNum);
         nextNode(iter);
 
-        // check if there is a block statement after the condition
-        if (match(iter, "{")) {
-            ASTnode* block = parseBlockStatement(iter);
-            insert(parent, _node, block, origLineNum);
-        }
-        // regular statement
-        else {
-            ASTnode* stmt = parseStatement(iter);
-            insert(parent,_node, stmt, origLineNum);
-        }
-        return parent;
+        // check if there is a block statement after the condition, if not it is
+        // a regular statement
+        if (match(iter, TK_L_BRACE))
+            loop->body = parseBlockStatement(iter);
+        else
+            loop->body = parseStatement(iter);
+        markLine(loop->body, origLineNum);
+        return loop;
     }
 
-    if (match(iter, "for")) {
-
+    if (match(iter, KW_FOR)) {
+        auto * loop = make<forNode>();
         iter = iter->sibling();
-
-        // initialization expression
-        parent = new ASTnode("FOR EXPRESSION 1", nullptr);
-        _node = parent;
         iter = iter->sibling();
 
-        ASTnode* init = convertToPostFix(iter);
-        insert(parent, _node, init, origLineNum);
+        // initialization expression
+        loop->init = parseExpression(iter);
+        markLine(loop->init, origLineNum);
         lineNum++;
 
         // condition
-        child = new ASTnode("FOR EXPRESSION 2", nullptr);
-        insert(parent, _node, child, origLineNum);
+        loop->conditionNewLine = origLineNum != lineNum;
         iter = iter->sibling();
         origLineNum = lineNum;
 
-        ASTnode* condition = convertToPostFix(iter);
-        insert(parent,_node, condition, origLineNum);
+        loop->condition = parseExpression(iter);
+        markLine(loop->condition, origLineNum);
         nextNode(iter);
         lineNum++;
 
         // iteration statement
-        child = new ASTnode("FOR EXPRESSION 3", nullptr);
-        insert(parent, _node, child, origLineNum);
+        loop->updateNewLine = origLineNum != lineNum;
         origLineNum = lineNum;
 
-        ASTnode* update = convertToPostFix(iter);
-        insert(parent,_node, update, origLineNum);
+        loop->update = parseExpression(iter);
+        markLine(loop->update, origLineNum);
         origLineNum = lineNum;
         lineNum++;
 
         // iterate to next node
         nextNode(iter);
 
-        if (match(iter, "{")) {
-            ASTnode* block = parseBlockStatement(iter);
-            insert(parent,_node, block, origLineNum);
-        } else {
-            ASTnode* stmt = parseStatement(iter);
-            insert(parent,_node, stmt, origLineNum);
-        }
+        if (match(iter, TK_L_BRACE))
+            loop->body = parseBlockStatement(iter);
+        else
+            loop->body = parseStatement(iter);
+        markLine(loop->body, origLineNum);
 
-        return parent;
+        return loop;
     }
     return nullptr; // should not get called
 }
@@ -671,104 +663,136 @@ ASTnode * AST::parseIterationStatement(node *& iter)
  * This parses a user function call
  *
  * @param iter current CST node
- * @return the AST structure of the call
+ * @return the call
  */
-ASTnode * AST::parseUserDefinedFunction(node *& iter)
+callNode * AST::parseUserDefinedFunction(cstIter& iter)
 {
-    int origLineNum = lineNum;
-    string prev = iter->content();
-
-    // create a flag node for the call
-    auto * parent = new ASTnode("call", nullptr);
-    auto * child = new ASTnode(iter->content(), ST->retrieveNode(prev, iter->scope()));
-    auto * _node = parent;
-    insert(parent, _node, child, origLineNum); // connect call node with function name
+    auto * call = make<callNode>(make<identifierNode>(iter->name(), ST->retrieveNode(iter->name(), iter->scope())));
+    call->statement = true;
     iter = iter->sibling(); // iterate to the first (
 
-    while (iter && prev != ")") {
-        // insert non-comma nodes
-        if ( !match(iter, ",")) {
-            child = new ASTnode(iter->content(), nullptr);
-            insert(parent, _node, child, origLineNum);
+    if (match(iter, TK_L_PAREN))
+    {
+        iter = iter->sibling();
+        vector<ASTnode *> args;
+        parseArguments(iter, args);
+        call->args = keep(args);
+    }
+    // iterate past the ) (a call without one is skipped up to the next one)
+    while (iter && !match(iter, TK_R_PAREN))
+        iter = iter->sibling();
+    if (iter)
+        iter = iter->sibling();
+    return call;
+}
+
+
+/***
+ * This parses the arguments of a call (or the values a printf outputs)
+ * @param iter the node after the "(", it is left on the ")"
+ * @param args the arguments are added to it
+ */
+void AST::parseArguments(cstIter& iter, vector<ASTnode *>& args)
+{
+    while (iter && !match(iter, TK_R_PAREN))
+    {
+        // skip the commas between the arguments
+        if (match(iter, TK_COMMA))
+        {
+            iter = iter->sibling();
+            continue;
         }
-        prev = iter->content();
+        ASTnode * arg = parseExpression(iter);
+        // the arguments are not closed
+        if (!arg)
+            break;
+        args.push_back(arg);
+    }
+}
+
+
+/***
+ * This parses the condition of an if or while statement, it ends at the ")" that
+ * closes the one it starts with (after any - or ! written before it)
+ * @param iter the first node of the condition, it is left on the ")" after it
+ * @return the condition
+ */
+ASTnode * AST::parseCondition(cstIter& iter)
+{
+    if (!iter)
+        return nullptr;
+    // - and ! before the parentheses apply to everything in them
+    tokenKind kind = punctuatorKind(iter->name().id());
+    if (PREFIX_OPERATOR[kind])
+    {
         iter = iter->sibling();
+        return make<unaryNode>(kind, parseCondition(iter));
     }
-    return parent;
+    if (match(iter, TK_L_PAREN))
+        iter = iter->sibling();
+    return parseExpression(iter);
 }
 
 
 /***
  * This parses an assignment statement
- * @param iter
- * @return
+ * @param iter current CST node
+ * @return the assignment
  */
-ASTnode * AST::parseAssignmentStatement(node *& iter)
+assignNode * AST::parseAssignmentStatement(cstIter& iter)
 {
-    // create a parent node with a flag node
-    auto * assignmentNode = new ASTnode(ASSIGNMENT, ST->retrieveNode(iter->content(), iter->scope()));
-    auto * _node = assignmentNode;
-    // convert the entire assignment statement to post fix and insert it
-    auto * child = convertToPostFix(iter);
-    insert(assignmentNode, _node, child, lineNum);
-    return assignmentNode;
+    // parse the entire assignment statement as an expression
+    ASTnode * expression = parseExpression(iter);
+    auto * statement = expression && expression->kind == AK_ASSIGN ? (assignNode *) expression
+                                                                    : make<assignNode>(nullptr, expression);
+    statement->statement = true;
+    return statement;
 }
 
 
 /***
  * This parses a selection statement (conditions)
  * @param iter the current place in the CST
- * @return an AST structure of the selection statement
+ * @return the selection statement
  */
-ASTnode * AST::parseSelectionStatement(node *& iter)
+ifNode * AST::parseSelectionStatement(cstIter& iter)
 {
-    // set parent node and related parameters
+    // set the statement and related parameters
     int origLineNum = lineNum;
-    auto * parent = new ASTnode("if", nullptr);
-    auto * _node = parent;
-    ASTnode* child = nullptr;
-    iter = iter->sibling(); // iterate to first node of the expression
-
-    // convert the condition to post fix
-    child = convertToPostFix(iter);
-    insert(parent, _node, child, origLineNum);
+    auto * statement = make<ifNode>();
+    iter = iter->sibling(); // iterate to the ( of the condition
+
+    // parse the condition
+    statement->condition = parseCondition(iter);
+    markLine(statement->condition, origLineNum);
     origLineNum = lineNum;
     nextNode(iter);
 
-    // if the condition has a block statement
-    if (match(iter, "{")) {
-        ASTnode* block = parseBlockStatement(iter);
-        insert(parent, _node, block ,origLineNum);
-    }
-    // single line statement
-    else {
-        ASTnode* stmt = parseStatement(iter);
-        insert(parent,_node, stmt,origLineNum);
-    }
+    // if the condition has a block statement, if not it has a single line statement
+    if (match(iter, TK_L_BRACE))
+        statement->thenBranch = parseBlockStatement(iter);
+    else
+        statement->thenBranch = parseStatement(iter);
+    markLine(statement->thenBranch, origLineNum);
 
 
     // is there an else after the if statement(s)
-    if (match(iter, "else")) {
+    if (match(iter, KW_ELSE)) {
 
-        // set the parent node and iterate to the next node
-        child = new ASTnode("else", nullptr);
-        insert(parent, _node, child, origLineNum);
+        // mark the else and iterate to the next node
+        statement->elseNewLine = origLineNum != lineNum;
         origLineNum = lineNum;
         nextNode(iter);
 
-        // else statement has a block statement
-        if (match(iter, "{")) {
-            ASTnode* block = parseBlockStatement(iter);
-            insert(parent,_node, block,origLineNum);
-        }
-        // it only has a single line statement
-        else {
-            ASTnode* stmt = parseStatement(iter);
-            insert(parent,_node, stmt,origLineNum);
-        }
+        // else statement has a block statement, if not it only has a single line statement
+        if (match(iter, TK_L_BRACE))
+            statement->elseBranch = parseBlockStatement(iter);
+        else
+            statement->elseBranch = parseStatement(iter);
+        markLine(statement->elseBranch, origLineNum);
     }
 
-    return parent;
+    return statement;
 }
 
 
@@ -777,55 +801,33 @@ ASTnode * AST::parseSelectionStatement(node *& iter)
  * @param iter current CST node
  * @return true if the node contains an operator, false if not
  */
-bool AST::isOperator(node * iter)
+bool AST::isOperator(cstIter iter)
 {
-    return (iter->content() == "+" || iter->content() == "-" || iter->content() == "*" ||
-            iter->content() == "/" || iter->content() == "%" || iter->content() == "!" ||
-            iter->content() == "&&" || iter->content() == "||" || iter->content() == "==" ||
-            iter->content() == "!=" || iter->content() == "<="  || iter->content() == ">=" ||
-            iter->content() == "<" || iter->content() == ">" || iter->content() == "=" );
+    return isOperator(punctuatorKind(iter->name().id()));
 }
 
 
 /***
- * This function checks if a given string contains only an operator
- * @param iter current string
- * @return true if the string contains only an operator, false if not
+ * This function checks if a given special token is an operator written between two
+ * operands
+ * @param kind the special token
+ * @return true if it is an operator, false if not
  */
-bool AST::isOpString(const string& iter)
+bool AST::isOperator(tokenKind kind)
 {
-    return (iter == "+" || iter == "-" || iter == "*" ||
-            iter == "/" || iter == "%" || iter == "!" ||
-            iter == "&&" || iter == "||" || iter == "==" ||
-            iter == "!=" || iter == "<="  || iter == ">=" ||
-            iter == "<" || iter == ">" || iter == "=" );
+    return OPERATOR_PRECEDENCE[kind] != 0;
 }
 
 
 /***
  * This returns the precedence of a given operator
- * (lower the value the more priority)
+ * (lower the value the more priority, see OPERATOR_PRECEDENCE)
  * @param op the given operator
  * @return the given value of their precedence
  */
-int AST::precedence(const string& op)
-{
-    if (op == "!")
-        return 1;
-    else if (op == "*" || op == "/" || op == "%")
-        return 2;
-    else if (op == "+" || op == "-")
-        return 3;
-    else if (op == "<" || op == ">" || op == ">=" || op == "<=")
-        return 4;
-    else if (op == "==" || op == "!=")
-        return 5;
-    else if (op == "&&")
-        return 6;
-    else if (op == "||")
-        return 7;
-    else
-        return 8; // assignment
+int AST::precedence(tokenKind op)
+{
+    return OPERATOR_PRECEDENCE[op];
 }
 
 
@@ -834,114 +836,131 @@ int AST::precedence(const string& op)
  * @param op the given operator
  * @return true if it is left-associative, false if not
  */
-bool AST::isLeftAssociative(const string& op)
+bool AST::isLeftAssociative(tokenKind op)
 {
-    if (op == "!" || op == "=" || op == "+=" || op == "-=") {
-        return false;
-    }
-    return true;
+    return !RIGHT_ASSOCIATIVE[op];
 }
 
 
 /***
- * This converts a set expression and converts it to post fix
- *
- * @param iter current CST node
- * @return the head node of the converted expression
+ * This parses an operand of an expression: a name, number, TRUE/FALSE, char, string,
+ * call, element of an array, expression in parentheses or operand after - or !
+ * @param iter current CST node, it is left on the node after the operand
+ * @return the operand (null if the node cannot start one, only in a program with errors)
  */
-ASTnode * AST::convertToPostFix(node *& iter)
+ASTnode * AST::parseOperand(cstIter& iter)
 {
-    stack<string> opStack;
-    ASTnode * parent = nullptr, *child = nullptr;
-    auto * _node = parent;
-
-    int origLineNum = lineNum;
-    while (iter && iter->sibling() && !match(iter, "{") && !match(iter, ";"))
+    tokenKind kind = punctuatorKind(iter->name().id());
+    // - and ! apply to the operand after them alone
+    if (PREFIX_OPERATOR[kind])
     {
-        // non-operator
-        if (!isOperator(iter) && !match(iter, "(") && !match(iter, ")") )
-        {
-
-            if ((match(iter, "'")) || (match(iter, "\"")))
-            {
-                child = parseString(iter);
-                insert(parent, _node, child, origLineNum);
-                continue;
-            }
-            else
-                child = new ASTnode(iter->content(), nullptr);
-            insert(parent, _node, child, origLineNum);
+        nextNode(iter);
+        return make<unaryNode>(kind, parseExpression(iter, PREFIX_PRECEDENCE));
+    }
+    if (kind == TK_L_PAREN)
+    {
+        nextNode(iter);
+        ASTnode * group = parseExpression(iter);
+        if (match(iter, TK_R_PAREN))
+            nextNode(iter);
+        return group;
+    }
+    if (kind == TK_SINGLE_QUOTE || kind == TK_DOUBLE_QUOTE)
+    {
+        literalNode * literal = parseString(iter);
+        nextNode(iter);
+        return literal;
+    }
+    // any other operator or punctuation ends the expression
+    if (kind != TK_UNKNOWN)
+        return nullptr;
 
-            // user-defined function
-            string prev;
-            auto * peek = iter->sibling();
-            if (match(peek, "("))
-            {
-                iter = iter->sibling();
-                while (iter && prev != ")") {
-
-                    if (!match(iter, ",")) {
-                        child = new ASTnode(iter->content(), nullptr);
-                        insert(parent, _node, child, origLineNum);
-                    }
-                    prev = iter->content();
-                    iter = iter->sibling();
-                }
-                continue;
+    cstIter peek = iter->sibling();
+    // user-defined function (or getchar)
+    if (match(peek, TK_L_PAREN))
+    {
+        bool builtIn = match(iter, KW_GETCHAR);
+        internedString name = iter->name();
+        iter = peek->sibling(); // iterate past (
+        vector<ASTnode *> args;
+        parseArguments(iter, args);
+        if (match(iter, TK_R_PAREN))
+            nextNode(iter);
+        // getchar takes no arguments
+        if (builtIn && args.empty())
+            return make<getcharNode>();
+        auto * call = make<callNode>(make<identifierNode>(name));
+        call->args = keep(args);
+        return call;
+    }
 
-            }
-        }
-        // operator case
-        else if (isOperator(iter))
-        {
-            string curOp = iter->content();
-            int curPrecedence = precedence(curOp);
+    ASTnode * operand;
+    if (iter->kind() == TK_INTEGER)
+    {
+        auto * literal = make<literalNode>(LK_INTEGER, iter->name());
+        decodeInteger(iter->content(), literal->value);
+        operand = literal;
+    }
+    else if (match(iter, KW_TRUE) || match(iter, KW_FALSE))
+    {
+        auto * literal = make<literalNode>(LK_BOOL, iter->name());
+        literal->value = match(iter, KW_TRUE);
+        operand = literal;
+    }
+    else if (match(peek, TK_L_BRACKET))
+    {
+        auto * name = make<identifierNode>(iter->name());
+        nextNode(iter); // iterate to [
+        nextNode(iter); // iterate to the index
+        operand = make<indexNode>(name, parseExpression(iter));
+        if (!match(iter, TK_R_BRACKET))
+            return operand;
+    }
+    else
+        operand = make<identifierNode>(iter->name());
+    nextNode(iter);
+    return operand;
+}
 
-            while (!opStack.empty() && isOpString(opStack.top()) &&
-            (curPrecedence > precedence(opStack.top())
-                || (curPrecedence == precedence(opStack.top()) && isLeftAssociative(curOp)) ))
-            {
-                child = new ASTnode(opStack.top(), nullptr);
-                insert(parent, _node, child, origLineNum);
-                opStack.pop();
-            }
-            opStack.push(curOp);
-        }
-        else if (match(iter, "("))
-        {
-            opStack.emplace("(");
-        }
-        else if (match(iter, ")"))
-        {
 
-            while (opStack.top() != "(")
-            {
-                child = new ASTnode(opStack.top(), nullptr);
-                insert(parent, _node, child, origLineNum);
-                opStack.pop();
-            }
-            opStack.pop();
-        }
-        nextNode(iter);
-        origLineNum = lineNum;
-    }
+/***
+ * This parses an expression into a tree by precedence climbing: an operand, then every
+ * operator that binds tighter than the limit along with the expression on its right,
+ * which only takes the operators that bind tighter still (see OPERATOR_PRECEDENCE).
+ * The expression stops at the first node that is neither, like ";", "," or ")"
+ *
+ * @param iter current CST node, it is left on the node the expression stops at
+ * @param limit the operators taken have a lower precedence than this
+ * @return the root of the expression (null if it is empty)
+ */
+ASTnode * AST::parseExpression(cstIter& iter, int limit)
+{
+    if (!iter)
+        return nullptr;
+    ASTnode * left = parseOperand(iter);
 
-    while (!opStack.empty())
+    while (iter)
     {
-        if (opStack.top() != "(" && opStack.top() != ")") {
-            child = new ASTnode(opStack.top(), nullptr);
-            insert(parent, _node, child, origLineNum);
-        }
-        opStack.pop();
+        tokenKind op = punctuatorKind(iter->name().id());
+        if (!isOperator(op) || precedence(op) >= limit)
+            break;
+        nextNode(iter);
+        // an operator that groups right to left also leaves the ones as tight as it
+        // to the right
+        ASTnode * right = parseExpression(iter, isLeftAssociative(op) ? precedence(op) : precedence(op) + 1);
+        if (op == TK_ASSIGNMENT_OPERATOR)
+            left = make<assignNode>(left, right);
+        else
+            left = make<binaryNode>(op, left, right);
     }
-    return parent;
+    return left;
 
 }
 
 
 /***
- * This outputs the contents of a CST in a human-readable way
- * @param outputFile file to hold the contents of the CST
+ * This outputs the contents of an AST in a human-readable way
+ * @param outputFile file to hold the contents of the AST
  */
 void AST::output(const string& outputFile)
 {
@@ -954,57 +973,8 @@ void AST::output(const string& outputFile)
         exit(3);
     }
 
-    traverseAST(head,outFS);
-    if (head)
-        outFS << "null";
+    astPrinter(outFS).print(_declarations);
 
     outFS.close();
 
 }
-
-
-#include <iomanip>
-#define ORIGINAL_LENGTH 1
-int lineWid = ORIGINAL_LENGTH;
-
-
-/***
- * This traverse the AST and outputs the tokens in their tree
- * structure
- * @param head root node of the tree
- * @param outFS output file stream
- */
-void AST::traverseAST(ASTnode * head, ofstream& outFS)
-{
-//    if (!head)
-//        return;
-//    outFS << "[" << head->content() << "]->";
-//    if (head->sibling())
-//        lineWid += head->content().size() + 4;
-//    traverseAST(head->sibling(), outFS);
-//
-//    if (head->child())
-//    {
-//        outFS << "null\n" << setw(lineWid);
-//        traverseAST(head->child(), outFS);
-//        lineWid = ORIGINAL_LENGTH;
-//
-//    }
-    if (!head)
-        return;
-    outFS << "[" << head->content() << "]->";
-//    if (head->sibling())
-//        lineWidth += head->content().size() + 4;
-//    outFS << head->content() << " ";
-//    if (head->sibling())
-//        lineWidth += head->content().size();
-
-    traverseAST(head->sibling(), outFS);
-
-    if (head->child()) {
-        outFS << "null\n\n" << setw(lineWid);
-        traverseAST(head->child(), outFS);
-        lineWid = ORIGINAL_LENGTH;
-    }
-
-}
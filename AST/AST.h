@@ -4,7 +4,9 @@
 
 #ifndef ASSIGNMENT4_AST_H
 #define ASSIGNMENT4_AST_H
+#include <algorithm>
 #include "../CST/CST.h"
+#include "../arena/arena.h"
 #include "ASTnode.h"
 
 
@@ -17,40 +19,80 @@
 class AST {
 public:
     AST(CST * cst, symbolTable * ST);
+    explicit AST(symbolTable * ST);
+    ~AST();
+    AST(const AST&) = delete;
+    AST& operator=(const AST&) = delete;
 
-    void nextNode(node *& iter);
-    void insert(ASTnode *& parent,  ASTnode *& _node, ASTnode *& child,  int origLineNum);
-    void insertSibling(ASTnode *& parent, ASTnode *& _node, ASTnode *& child);
-    void insertChild(ASTnode *& parent, ASTnode *& _node, ASTnode *& child);
-    void parseToGivenChar(const string& character, node *& iter);
-    void traverseAST(ASTnode * head, ofstream& outFS);
+    void addDeclarations(cstIter& iter, uint32_t end);
+    void append(AST * other);
+    void release();
+
+    void nextNode(cstIter& iter);
+    void markLine(ASTnode * child, int origLineNum) const;
+    void parseToGivenChar(tokenKind character, cstIter& iter);
     void output(const string& output);
+    [[nodiscard]] const vector<ASTnode *>& declarations() const { return _declarations; }
+
+    static bool match(cstIter iter, internedString str);
+    static bool match(cstIter iter, tokenKind kind);
+    static bool match(cstIter iter, keywordKind word);
+    static bool isDatatype(cstIter iter);
+    static bool isOperator(cstIter iter);
+    static bool isOperator(tokenKind kind);
+    static bool isLeftAssociative(tokenKind op);
+    static int precedence(tokenKind op);
 
-    static bool match(node * iter, const string& str);
-    static bool isDatatype(node * iter);
-    static bool isOperator(node * iter);
-    static bool isOpString(const string& iter);
-    static bool isLeftAssociative(const string& iter);
-    static int precedence(const string& op);
-
-    ASTnode * parseVarDeclaration(node *& iter);
-    ASTnode * parseSelectionStatement(node *& iter);
-    ASTnode * parseFunctionDeclaration(node *& iter);
-    ASTnode * parseBlockStatement( node *& iter);
-    ASTnode * parseCompoundStatement( node *& iter );
-    ASTnode * parseStatement(node *& iter);
-    ASTnode * parseAssignmentStatement(node *& iter);
-    ASTnode * getLastNode(ASTnode * root);
-    ASTnode * convertToPostFix(node *& iter);
-    ASTnode * parseUserDefinedFunction(node *& iter);
-    ASTnode * parseReturnStatement(node *& iter);
-    ASTnode * parsePrintfStatement(node *& iter);
-    ASTnode * parseString(node *& iter);
-    ASTnode * parseIterationStatement(node *& iter);
+    declarationNode * parseVarDeclaration(cstIter& iter);
+    ifNode * parseSelectionStatement(cstIter& iter);
+    functionNode * parseFunctionDeclaration(cstIter& iter);
+    blockNode * parseBlockStatement( cstIter& iter);
+    void parseCompoundStatement(cstIter& iter, vector<ASTnode *>& statements);
+    ASTnode * parseStatement(cstIter& iter);
+    assignNode * parseAssignmentStatement(cstIter& iter);
+    ASTnode * parseExpression(cstIter& iter, int limit = EXPRESSION_PRECEDENCE);
+    ASTnode * parseCondition(cstIter& iter);
+    ASTnode * parseOperand(cstIter& iter);
+    void parseArguments(cstIter& iter, vector<ASTnode *>& args);
+    callNode * parseUserDefinedFunction(cstIter& iter);
+    returnNode * parseReturnStatement(cstIter& iter);
+    printfNode * parsePrintfStatement(cstIter& iter);
+    literalNode * parseString(cstIter& iter);
+    ASTnode * parseIterationStatement(cstIter& iter);
+    [[nodiscard]] size_t bytesUsed() const { return nodes.bytesUsed(); }
 
 
 private:
-    ASTnode * head;
+    literalNode * quotedLiteral(tokenKind quote, internedString text);
+    string_view keep(string_view text);
+
+    /***
+     * This makes a node in the arena
+     * @param args what the node is constructed from
+     * @return the node
+     */
+    template <typename T, typename... Args>
+    T * make(Args&&... args) { return nodes.make<T>(std::forward<Args>(args)...); }
+
+    /***
+     * This copies the nodes the parser gathered under a node into the arena
+     * @param items the nodes
+     * @return the list in the arena
+     */
+    template <typename T>
+    nodeList<T> keep(const vector<T>& items)
+    {
+        nodeList<T> list;
+        if (items.empty())
+            return list;
+        list.items = (T *) nodes.allocate(items.size() * sizeof(T), alignof(T));
+        copy(items.begin(), items.end(), list.items);
+        list.count = items.size();
+        return list;
+    }
+
+    arena nodes; // holds every node of the AST, they are all freed when it is destroyed
+    vector<ASTnode *> _declarations; // functions, procedures and global variables in order
     symbolTable * ST;
     int lineNum = 1; // used for insertions
 };
@@ -4,32 +4,211 @@
 
 #ifndef ASSIGNMENT4_ASTNODE_H
 #define ASSIGNMENT4_ASTNODE_H
-#include <string>
-#include <utility>
+#include <cstdint>
+#include <string_view>
 #include "../symbolTable/stNode.h"
+#include "../interner/interner.h"
+#include "../tokenize/tokenKind.h"
 using namespace std;
 
 
-class ASTnode {
+// what an AST node is, every kind has its own node type below
+enum astKind : uint8_t {
+    AK_FUNCTION, AK_DECLARATION, AK_BLOCK, AK_IF, AK_WHILE, AK_FOR, AK_RETURN, AK_PRINTF,
+    AK_ASSIGN, AK_CALL, AK_GETCHAR, AK_INDEX, AK_BINARY, AK_UNARY, AK_IDENTIFIER, AK_LITERAL,
+    AK_COUNT
+};
+
+// what a literal holds
+enum literalKind : uint8_t {
+    LK_INTEGER, LK_CHAR, LK_STRING, LK_BOOL
+};
+
+
+/***
+ * This is a list of the nodes under a node, it is copied into the AST's arena once the
+ * parser has all of them
+ */
+template <typename T>
+struct nodeList {
+    T * items = nullptr;
+    uint32_t count = 0;
+
+    [[nodiscard]] T * begin() const { return items; }
+    [[nodiscard]] T * end() const { return items + count; }
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    T& operator[](size_t idx) const { return items[idx]; }
+};
+
+
+/***
+ * This is the part every AST node starts with, the kind says which node type it is.
+ * The AST used to be output one line per structure the parser linked as a child, the
+ * flag keeps where those lines started so the output stays the same (see astPrinter).
+ * Nodes are made in the AST's arena and freed all at once with it, so no node type has
+ * a destructor of its own
+ */
+struct ASTnode {
+    explicit ASTnode(astKind kind): kind{kind} {}
+
+    const astKind kind;
+    bool newLine = false; // the node starts a new line of the output
+};
+
+
+/***
+ * An integer, char, string or bool written in the program
+ */
+struct literalNode : ASTnode {
+    literalNode(literalKind type, internedString text): ASTnode(AK_LITERAL), type{type}, text{text} {}
+
+    literalKind type;
+    internedString text; // as it is written (without the quotes, empty for "")
+    tokenKind quote = TK_UNKNOWN; // the quote a char or string is in
+    int value = 0; // an integer's value, a char's code or 1/0 for TRUE/FALSE
+    string_view decoded; // the text of a char or string with its escapes replaced (in the arena)
+};
+
+
+/***
+ * A name used in an expression, the resolver binds it to what it names
+ */
+struct identifierNode : ASTnode {
+    explicit identifierNode(internedString name, stNode * symbol = nullptr):
+    ASTnode(AK_IDENTIFIER), name{name}, symbol{symbol} {}
 
-public:
+    internedString name;
+    stNode * symbol; // null until it is bound (names of nothing stay null)
+    frameSlot slot; // where the variable lives (see resolver)
+};
+
+
+struct unaryNode : ASTnode {
+    unaryNode(tokenKind op, ASTnode * operand): ASTnode(AK_UNARY), op{op}, operand{operand} {}
+
+    tokenKind op;
+    ASTnode * operand;
+};
+
+
+struct binaryNode : ASTnode {
+    binaryNode(tokenKind op, ASTnode * left, ASTnode * right): ASTnode(AK_BINARY), op{op}, left{left}, right{right} {}
+
+    tokenKind op;
+    ASTnode * left, * right;
+};
+
+
+/***
+ * An assignment, either a statement of its own or part of an expression (the first
+ * expression of a for loop)
+ */
+struct assignNode : ASTnode {
+    assignNode(ASTnode * target, ASTnode * value): ASTnode(AK_ASSIGN), target{target}, value{value} {}
+
+    ASTnode * target; // an identifier or index (null if the statement assigns nothing)
+    ASTnode * value;
+    bool statement = false;
+};
+
+
+struct indexNode : ASTnode {
+    indexNode(identifierNode * array, ASTnode * index): ASTnode(AK_INDEX), array{array}, index{index} {}
+
+    identifierNode * array;
+    ASTnode * index;
+};
 
-    ASTnode(string title, stNode * _node): _sibling{nullptr}, _child{nullptr},
-            _title{std::move(title)}, _node{_node} {}
 
-    ASTnode * sibling() { return _sibling; }
-    ASTnode * child() { return _child; }
-    stNode * node() { return _node; }
-    string content() { return _title; }
+/***
+ * A call of a function or procedure, either a statement of its own or part of an
+ * expression
+ */
+struct callNode : ASTnode {
+    explicit callNode(identifierNode * callee): ASTnode(AK_CALL), callee{callee} {}
+
+    identifierNode * callee;
+    nodeList<ASTnode *> args;
+    bool statement = false;
+};
+
+
+struct getcharNode : ASTnode {
+    getcharNode(): ASTnode(AK_GETCHAR) {}
+};
+
+
+/***
+ * The variables of one declaration statement (a global or local declaration)
+ */
+struct declarationNode : ASTnode {
+    declarationNode(): ASTnode(AK_DECLARATION) {}
+
+    nodeList<stNode *> symbols; // a name the symbol table does not have is null
+};
+
+
+struct blockNode : ASTnode {
+    blockNode(): ASTnode(AK_BLOCK) {}
+
+    nodeList<ASTnode *> statements;
+    bool endNewLine = false; // the end of the block starts a new line of the output
+};
+
+
+/***
+ * A function or procedure declaration and its body
+ */
+struct functionNode : ASTnode {
+    functionNode(stNode * symbol, blockNode * body): ASTnode(AK_FUNCTION), symbol{symbol}, body{body} {}
+
+    stNode * symbol;
+    blockNode * body;
+};
+
+
+struct ifNode : ASTnode {
+    ifNode(): ASTnode(AK_IF) {}
+
+    ASTnode * condition = nullptr;
+    ASTnode * thenBranch = nullptr;
+    ASTnode * elseBranch = nullptr; // null if there is no else
+    bool elseNewLine = false; // the else starts a new line of the output
+};
+
+
+struct whileNode : ASTnode {
+    whileNode(): ASTnode(AK_WHILE) {}
+
+    ASTnode * condition = nullptr;
+    ASTnode * body = nullptr;
+};
+
+
+struct forNode : ASTnode {
+    forNode(): ASTnode(AK_FOR) {}
+
+    ASTnode * init = nullptr;
+    ASTnode * condition = nullptr;
+    ASTnode * update = nullptr;
+    ASTnode * body = nullptr;
+    bool conditionNewLine = false, updateNewLine = false; // the second/third expression starts a new line
+};
+
+
+struct returnNode : ASTnode {
+    returnNode(): ASTnode(AK_RETURN) {}
+
+    ASTnode * value = nullptr; // null for a return without a value
+};
 
-    void sibling(ASTnode * astNode) { _sibling = astNode; }
-    void child(ASTnode * astNode) { _child = astNode; }
 
+struct printfNode : ASTnode {
+    printfNode(): ASTnode(AK_PRINTF) {}
 
-private:
-    string _title;
-    ASTnode * _sibling, * _child;
-    stNode * _node;
+    literalNode * format = nullptr;
+    nodeList<ASTnode *> args;
 };
 
 
@@ -0,0 +1,214 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "astPrinter.h"
+#include "AST.h"
+using namespace std;
+
+
+/***
+ * This outputs the declarations of an AST, null ends the last line
+ * @param declarations the declarations
+ */
+void astPrinter::print(const vector<ASTnode *>& declarations)
+{
+    for (const ASTnode * declaration : declarations)
+        print(declaration);
+    if (started)
+        outFS << "null";
+}
+
+
+/***
+ * This outputs one title, ending the line before it first if it starts a new one
+ * @param text the title
+ */
+void astPrinter::title(string_view text)
+{
+    // the first title has no line before it to end
+    if (pendingLine && started)
+        outFS << "null\n\n";
+    pendingLine = false;
+    started = true;
+    outFS << "[" << text << "]->";
+}
+
+
+/***
+ * This outputs a node and the nodes under it (statements in order, expressions in
+ * postfix order)
+ * @param node the node (nothing is output if it is null)
+ */
+void astPrinter::print(const ASTnode * node)
+{
+    if (!node)
+        return;
+    if (node->newLine)
+        newLine();
+
+    switch (node->kind)
+    {
+        case AK_FUNCTION:
+        {
+            auto * function = (const functionNode *) node;
+            title(DECLARATION);
+            print(function->body);
+            break;
+        }
+        case AK_DECLARATION:
+        {
+            // each variable after the first is on a line of its own
+            auto * declaration = (const declarationNode *) node;
+            for (size_t i = 0; i < declaration->symbols.size(); i++)
+            {
+                if (i)
+                    newLine();
+                title(DECLARATION);
+            }
+            break;
+        }
+        case AK_BLOCK:
+        {
+            auto * block = (const blockNode *) node;
+            title(BEGIN_BLOCK);
+            for (const ASTnode * statement : block->statements)
+                print(statement);
+            if (block->endNewLine)
+                newLine();
+            title(END_BLOCK);
+            break;
+        }
+        case AK_IF:
+        {
+            auto * statement = (const ifNode *) node;
+            title(KW_IF);
+            print(statement->condition);
+            print(statement->thenBranch);
+            if (statement->elseBranch)
+            {
+                if (statement->elseNewLine)
+                    newLine();
+                title(KW_ELSE);
+                print(statement->elseBranch);
+            }
+            break;
+        }
+        case AK_WHILE:
+        {
+            auto * loop = (const whileNode *) node;
+            title(KW_WHILE);
+            print(loop->condition);
+            print(loop->body);
+            break;
+        }
+        case AK_FOR:
+        {
+            auto * loop = (const forNode *) node;
+            title("FOR EXPRESSION 1");
+            print(loop->init);
+            if (loop->conditionNewLine)
+                newLine();
+            title("FOR EXPRESSION 2");
+            print(loop->condition);
+            if (loop->updateNewLine)
+                newLine();
+            title("FOR EXPRESSION 3");
+            print(loop->update);
+            print(loop->body);
+            break;
+        }
+        case AK_RETURN:
+        {
+            title("RETURN");
+            print(((const returnNode *) node)->value);
+            break;
+        }
+        case AK_PRINTF:
+        {
+            // only the text of the format is output
+            auto * statement = (const printfNode *) node;
+            title(KW_PRINTF);
+            title(statement->format->text);
+            for (const ASTnode * arg : statement->args)
+                print(arg);
+            break;
+        }
+        case AK_ASSIGN:
+        {
+            auto * assignment = (const assignNode *) node;
+            if (assignment->statement)
+                title(ASSIGNMENT);
+            print(assignment->target);
+            print(assignment->value);
+            if (assignment->target)
+                title(TK_ASSIGNMENT_OPERATOR);
+            break;
+        }
+        case AK_CALL:
+        {
+            auto * call = (const callNode *) node;
+            if (call->statement)
+                title("call");
+            title(call->callee->name);
+            title(TK_L_PAREN);
+            for (const ASTnode * arg : call->args)
+                print(arg);
+            title(TK_R_PAREN);
+            break;
+        }
+        case AK_GETCHAR:
+        {
+            title(KW_GETCHAR);
+            title(TK_L_PAREN);
+            title(TK_R_PAREN);
+            break;
+        }
+        case AK_INDEX:
+        {
+            auto * element = (const indexNode *) node;
+            title(element->array->name);
+            title(TK_L_BRACKET);
+            print(element->index);
+            title(TK_R_BRACKET);
+            break;
+        }
+        case AK_BINARY:
+        {
+            auto * expression = (const binaryNode *) node;
+            print(expression->left);
+            print(expression->right);
+            title(expression->op);
+            break;
+        }
+        case AK_UNARY:
+        {
+            auto * expression = (const unaryNode *) node;
+            print(expression->operand);
+            title(expression->op);
+            break;
+        }
+        case AK_IDENTIFIER:
+        {
+            title(((const identifierNode *) node)->name);
+            break;
+        }
+        case AK_LITERAL:
+        {
+            auto * literal = (const literalNode *) node;
+            if (literal->type != LK_CHAR && literal->type != LK_STRING)
+            {
+                title(literal->text);
+                break;
+            }
+            // a char or string is output with its quotes
+            title(literal->quote);
+            if (!literal->text.empty())
+                title(literal->text);
+            title(literal->quote);
+            break;
+        }
+        default:
+            break;
+    }
+}
@@ -0,0 +1,42 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_ASTPRINTER_H
+#define ASSIGNMENT5_ASTPRINTER_H
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include "ASTnode.h"
+using namespace std;
+
+
+/***
+ * This outputs an AST the way it was output when its nodes were a chain of titles: each
+ * node is written as [title]-> (an expression in postfix order), and a node marked as
+ * starting a new line ends the line before it with null (see ASTnode::newLine)
+ */
+class astPrinter {
+
+public:
+    explicit astPrinter(ostream& outFS): outFS{outFS} {}
+
+    void print(const vector<ASTnode *>& declarations);
+
+private:
+    void print(const ASTnode * node);
+    void title(string_view text);
+    void title(const char * text) { title(string_view(text)); }
+    void title(internedString text) { title(text.view()); }
+    void title(tokenKind op) { title(internedString::fromId(punctuatorId(op))); }
+    void title(keywordKind word) { title(internedString::fromId(keywordId(word))); }
+    void newLine() { pendingLine = true; }
+
+    ostream& outFS;
+    bool started = false; // a title has been written
+    bool pendingLine = false; // the next title starts a new line
+
+};
+
+
+#endif //ASSIGNMENT5_ASTPRINTER_H
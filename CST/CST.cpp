@@ -4,38 +4,198 @@
 
 
 #include "CST.h"
+#include "../AST/AST.h"
 #include <cassert>
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <fstream>
 using namespace std;
 
 
+// a statement is checked for this spelling (it is not the getchar keyword), it is
+// interned once instead of for every statement (a reserved name, a reset keeps its ID)
+static const internedString GET_CHAR_STATEMENT("getChar");
+
+
+/***
+ * This is part of a program parsed on its own by parseInParallel, it starts at a top
+ * level function/procedure keyword and ends where the next part starts. The merge reads
+ * the part's lookups while it is still being parsed, they are guarded by its lock
+ */
+struct programPart {
+    tokenIter start, stop; // first token and the token the parse stopped at
+    uint32_t end = UINT32_MAX; // index of the first token of the next part
+    int lineNum = 1, prevScope = 0; // state of the parser at the start of the part
+    unique_ptr<symbolTable> table;
+    unique_ptr<CST> parser;
+    node * root = nullptr, * last = nullptr;
+    diagnostics errors;
+
+    mutex lock;
+    condition_variable changed; // signalled when a lookup is logged or the parse finishes
+    vector<symbolQuery> queries; // symbol table lookups in the order they were made
+    bool finished = false;
+    atomic<bool> cancelled{false}; // set once the merge will not use the part
+};
+
+
+// thrown out of the parse of a cancelled part (see stopIfCancelled)
+struct parseCancelled {};
+
+// thrown out of the parse when the token stream ends at a lex error (see stopIfCancelled)
+struct streamFailed {};
+
+// cancel flag of the part the thread is parsing (null when parsing a whole program)
+static thread_local const atomic<bool> * partCancelled = nullptr;
+
+
+/***
+ * This stops the parse of a part the merge is not going to use. Parsing from a place a
+ * serial parse never starts at can run into loops a serial parse never reaches, so the
+ * token matching functions (which every loop of the parser calls) check for it. It also
+ * stops the parse of a token stream that ended at a lex error, the parser would loop on
+ * the cut off program the same way
+ * @param iter the token being matched
+ */
+static inline void stopIfCancelled(const tokenIter& iter)
+{
+    if (partCancelled && partCancelled->load(memory_order_relaxed))
+        throw parseCancelled();
+    if (iter.owner() && iter.owner()->failed())
+        throw streamFailed();
+}
+
+
 /***
  * This is the main constructor for the CST
  * @param tokenHead head token node
  * @param outputFile the output file that will hold errors if encountered
  * @param ST the symbol table to be populated throughout the process
  * of constructing the CST
+ * @param ast the AST to add the declarations to as they are parsed (null to keep
+ * the whole CST instead)
+ * @param pool the threads to parse the functions and procedures on (null to parse
+ * them one after another)
+ * @param maxErrors the parse stops after the declaration that brings the errors up to
+ * this many (0 for no limit)
  */
-CST::CST(token * tokenHead, const string& outputFile, symbolTable * ST)
+CST::CST(tokenIter tokenHead, const string& outputFile, symbolTable * ST, AST * ast, threadPool * pool,
+         size_t maxErrors)
 {
     ofstream outFS;
+    diagnostics diag(maxErrors);
     this->ST = ST;
+    this->ast = ast;
+    this->pool = pool;
+    direct = ast != nullptr;
 
-    // clear the file
-    outFS.open(outputFile);
-    outFS.close();
+    node * root = nullptr;
+    try
+    {
+        root = parse(tokenHead, diag);
+    }
+    // the parse stops where a token stream ends at a lex error
+    catch (const streamFailed&) {}
+    bool lexed = !tokenHead.owner() || tokenHead.owner()->finish();
+
+    // keep only the flat copy of the tree (or finish the AST with the last declaration)
+    if (!direct)
+        tree = flatCST(root);
+    nodes.reset();
+    partParsers.clear();
+    if (direct && lexed)
+        buildAST(NO_NODE);
+
+    // a program that could not be lexed only has the lexer's error (in the token output
+    // file), the errors the parser found before the stream ended are dropped
+    if (!lexed)
+    {
+        errorDetected = true;
+        return;
+    }
 
+    // the errors are only written once the whole program is parsed
     outFS.open(outputFile);
 
     if (!outFS.is_open())
         throw runtime_error("CST FILE DID NOT OPEN\n");
+    diag.write(outFS);
+    outFS.close();
 
-    head = parse(tokenHead, outFS);
+}
 
-    outFS.close();
 
+/***
+ * This constructs a parser for one part of a program (see parseInParallel), it starts
+ * in the state the whole program's parser would be in at the start of the part
+ * @param ST an empty symbol table for the part
+ * @param lineNum line number at the start of the part
+ * @param prevScope number of functions and procedures before the part
+ * @param part the part
+ */
+CST::CST(symbolTable * ST, int lineNum, int prevScope, programPart * part)
+{
+    this->ST = ST;
+    this->lineNum = lineNum;
+    this->prevScope = prevScope;
+    this->part = part;
+    linkParamLists = true;
+    ast = nullptr;
+    direct = false;
+}
+
+
+/***
+ * This parses one piece of a program on its own (see session), the nodes are kept linked
+ * in the CST's arena instead of being flattened. The parser starts in the state the
+ * parser of the whole program would be in at the start of the piece
+ * @param head first token of the piece
+ * @param diag gets the errors
+ * @param ST the symbol table, it already holds the symbols of the program before the piece
+ * @param lineNum line number at the start of the piece
+ * @param prevScope number of functions and procedures before the piece
+ */
+CST::CST(tokenIter head, diagnostics& diag, symbolTable * ST, int lineNum, int prevScope)
+{
+    this->ST = ST;
+    this->lineNum = lineNum;
+    this->prevScope = prevScope;
+    ast = nullptr;
+    direct = false;
+    linkParamLists = true;
+    parseDeclarations(head, diag, pieceRoot, pieceLast, UINT32_MAX);
+}
+
+
+/***
+ * This changes the scope of every node of a piece that is not global by the same amount
+ * (see symbolTable::shiftScopes)
+ * @param delta amount the scopes change by
+ */
+void CST::shiftScopes(int delta)
+{
+    vector<node *> pending;
+    if (pieceRoot)
+        pending.push_back(pieceRoot);
+    while (!pending.empty())
+    {
+        node * cur = pending.back();
+        pending.pop_back();
+        for (; cur; cur = cur->sibling())
+        {
+            if (cur->scope() != 0)
+                cur->scope(cur->scope() + delta);
+            if (cur->child())
+                pending.push_back(cur->child());
+        }
+    }
+    prevScope += delta;
 }
 
 
@@ -61,6 +221,51 @@ void CST::insert(node *& parent, node *& curNode, node *& _node, node * lastNode
 }
 
 
+/***
+ * This is used instead of insert for the top level declarations when each one is added
+ * to an AST once it is parsed. The declaration is linked after the ones before it in the
+ * flat window, which completes them so the AST is built from them, then its nodes are
+ * freed
+ *
+ * @param _node the declaration to be inserted
+ * @param lastNode the last node of the declaration
+ * @param origLineNum the original line number prior to the creation of the declaration
+ */
+void CST::addDeclaration(node *& _node, node * lastNode, int origLineNum)
+{
+    if (!_node)
+        return;
+
+    // the window has its own copy of the nodes
+    uint32_t first = tree.append(_node, lastNode, origLineNum != lineNum);
+    _node = nullptr;
+    nodes.reset();
+
+    buildAST(first);
+}
+
+
+/***
+ * This builds the AST from the declarations in the flat window up to the given node
+ * and drops them from the window
+ * @param end index of the node to stop at (NO_NODE for the rest of the window)
+ */
+void CST::buildAST(uint32_t end)
+{
+    // the AST is only output for a program without errors, so it is not built
+    // once there is one
+    if (ast && !errorDetected)
+    {
+        cstIter iter = tree.root();
+        ast->addDeclarations(iter, end);
+        // the AST stops where the CST ends, so it would have stopped here
+        if (!iter)
+            ast = nullptr;
+    }
+    tree.release(end == NO_NODE ? tree.size() : end);
+}
+
+
 /***
  * This function inserts a node as a sibling to the CST
  *
@@ -124,56 +329,17 @@ void CST::insertChild(node *& parent, node *& curNode, node *& _node, node * las
 
 
 /***
- * This delete all the nodes in a CST (used in the destructor)
- * @param _node root node of the structure to be deallocated
- */
-void CST::deleteNodes(node * _node)
-{
-    node * temp = nullptr;
-    while (_node)
-    {
-        temp = _node;
-        if (_node->sibling())
-        {
-            _node = _node->sibling();
-        }
-        else if (_node->child())
-        {
-            _node = _node->child();
-        }
-        else
-        {
-            break;
-        }
-        delete temp;
-    }
-    delete _node;
-}
-
-
-/***
- * This gets the last/end node in a CST structure
- *
- * @param root the root node of the structure
- * @return the last node of the structure if
- * the root is not null (otherwise return the itself which is null)
+ * This makes the node of a string literal, the literal is not interned so its text is
+ * copied into the arena (the token's text is dropped once a stream moves past it)
+ * @param token the string literal
+ * @return the node
  */
-node* CST::getLastNode(node* root)
+node * CST::makeLiteral(const tokenIter& token)
 {
-    node* iter = root;
-    while (iter) {
-        // iterate to the last sibling
-        while (iter->sibling())
-            iter = iter->sibling();
-        // check if it has a child
-        if (iter->child()) {
-            iter = iter->child();
-        } else {
-
-            break;
-        }
-    }
-    return iter;
+    string_view text = token.content();
+    auto * copy = (char *) nodes.allocate(text.size(), 1);
+    text.copy(copy, text.size());
+    return nodes.make<node>(token, internedString::literal({copy, text.size()}), curScope);
 }
 
 
@@ -182,20 +348,47 @@ node* CST::getLastNode(node* root)
  * the recursive descent
  *
  * @param iter the iterator node for the token list
- * @param outFS the output file stream
+ * @param diag gets the errors
  * @return the root node of the CST
  */
-node * CST::parse(token *& iter, ofstream& outFS) {
+node * CST::parse(tokenIter& iter, diagnostics& diag) {
 
     // if the token list is empty, return immediately
     if (!iter)
         return nullptr;
 
     // initialize main node pointers
-    node * parent = nullptr, *_node = parent, * child = nullptr;
+    node * parent = nullptr, *_node = parent;
+
+    // whatever the parallel parse could not use is parsed here (with an error limit the
+    // program is parsed in order, a part can not tell when the errors before it reach it)
+    if (pool && pool->size() > 1 && !diag.limit())
+        parseInParallel(iter, diag, parent, _node);
+    parseDeclarations(iter, diag, parent, _node, UINT32_MAX);
+
+    // return parent node of the created CST structure
+    return parent;
+
+}
+
+
+/***
+ * This parses the top level declarations (functions, procedures and global variables)
+ * and links them into the CST
+ *
+ * @param iter the iterator node for the token list
+ * @param diag gets the errors
+ * @param parent root node of the CST
+ * @param _node last node of the CST
+ * @param end index of the token to stop at (a declaration that starts before it is
+ * parsed to its end)
+ */
+void CST::parseDeclarations(tokenIter& iter, diagnostics& diag, node *& parent, node *& _node, uint32_t end)
+{
+    node * child = nullptr, * last = nullptr;
     int origLineNum = lineNum;
 
-    while (iter)
+    while (iter && iter.index() < end && !diag.full())
     {
         // reset line change flag variable
         origLineNum = lineNum;
@@ -213,29 +406,367 @@ node * CST::parse(token *& iter, ofstream& outFS) {
             continue;
         }
         // procedure
-        if (match(iter, "procedure"))
-            child = parseProcedureDeclaration(iter, outFS);
+        if (match(iter, KW_PROCEDURE))
+            child = parseProcedureDeclaration(iter, diag, last);
         // function
-        else if (match(iter, "function"))
-            child = parseFunction(iter, outFS);
+        else if (match(iter, KW_FUNCTION))
+            child = parseFunction(iter, diag, last);
         // global variable
         else if (isDatatype(iter))
-            child =  parseDeclarationStatement(iter, outFS);
+            child =  parseDeclarationStatement(iter, diag, last);
         else
         {
-            // this is for an invalid statement in the global scope
+            // this is for an invalid statement in the global scope (its line is skipped)
             errorDetected = true;
-            outFS << "Syntax error on line " << lineNum << ": INVALID STATEMENT";
+            diag.report(DG_INVALID_STATEMENT, lineNum);
+            parseUntilEndl(iter);
+            child = nullptr;
         }
-        // insert the child node and flush the file stream to immediately report errors (if encountered)
-        insert(parent, _node, child, getLastNode(child), origLineNum);
-        outFS.flush();
+        // the first declaration of a part or piece is linked by whoever puts the program together
+        if (!parent && child)
+            firstStartsLine = origLineNum != lineNum;
+        // insert the child node
+        if (direct)
+            addDeclaration(child, last, origLineNum);
+        else
+            insert(parent, _node, child, last, origLineNum);
         // reset scope to 0
         curScope = 0;
     }
-    // return parent node of the created CST structure
-    return parent;
+}
+
+
+/***
+ * This holds the symbols of the parts already merged that a lookup made in a later part
+ * could find. Each function and procedure has a scope of its own, so a lookup from a
+ * later part can only find a global variable or a function in them
+ */
+struct priorSymbols {
+    unordered_set<uint64_t> globals; // name ID and array flag of each global variable
+    unordered_map<uint32_t, stNode *> functions; // first function node with each name
+    bool anyGlobal = false;
+
+    static uint64_t globalKey(internedString name, bool isArr) { return (uint64_t) name.id() << 1 | isArr; }
+    bool agreeWith(const vector<symbolQuery>& queries, size_t& checked) const;
+    void add(stNode * head);
+};
+
+
+/***
+ * This checks that the lookups a part made in its own symbol table would get the same
+ * answers from the whole program's table, which holds the earlier parts' nodes first
+ * (see symbolTable::inUse, exists and retrieveNode)
+ * @param queries the lookups of the part in the order they were made
+ * @param checked number of lookups already checked (moved past the ones checked now)
+ * @return true if every answer is the same
+ */
+bool priorSymbols::agreeWith(const vector<symbolQuery>& queries, size_t& checked) const
+{
+    for (; checked < queries.size(); checked++)
+    {
+        const symbolQuery& query = queries[checked];
+        switch (query.kind)
+        {
+            case SQ_IN_USE:
+                // a global with the same name is found before anything in the part
+                if (globals.count(globalKey(query.name, query.isArr)) && !(query.answer && query.foundScope == 0))
+                    return false;
+                break;
+            case SQ_EXISTS:
+                // any global variable counts
+                if (anyGlobal && !query.answer)
+                    return false;
+                break;
+            case SQ_NOT_INDEXABLE:
+            {
+                // a function with the name is found before anything in the part
+                auto function = functions.find(query.name.id());
+                if (function != functions.end() && query.answer != !function->second->isArr())
+                    return false;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+
+/***
+ * This adds the nodes of a merged part
+ * @param head first node of the part's symbol table
+ */
+void priorSymbols::add(stNode * head)
+{
+    for (stNode * entry = head; entry; entry = entry->next())
+    {
+        if (entry->scope() == 0)
+        {
+            anyGlobal = true;
+            globals.insert(globalKey(entry->name(), entry->isArr()));
+        }
+        if (entry->kind() == SK_FUNCTION)
+            functions.emplace(entry->name().id(), entry);
+    }
+}
+
+
+/***
+ * This splits a program into parts at the top level function and procedure keywords
+ * (the ones outside of braces), a part is at least MIN_PART_TOKENS long when it can be.
+ * The line number and scope at the start of each part are counted instead of parsed,
+ * the merge checks them before a part is used
+ * @param parts gets the parts
+ * @param head first token of the program
+ * @param lineNum line number at the first token
+ * @param prevScope number of functions and procedures before the first token
+ * @param count number of parts wanted
+ */
+static void splitProgram(deque<programPart>& parts, tokenIter head, int lineNum, int prevScope, size_t count)
+{
+    struct boundary {
+        tokenIter start;
+        int lineNum, prevScope;
+    };
+    vector<boundary> boundaries;
+
+    // this reads the whole program (a token stream lexes the rest of it), the parsers
+    // of the parts only read tokens so they can share them
+    int depth = 0, lines = lineNum, definitions = prevScope;
+    tokenIter iter = head;
+    for (; iter; iter = iter->next())
+    {
+        if (iter->isEndlToken())
+            lines++;
+        else if (CST::match(iter, TK_L_BRACE))
+            depth++;
+        else if (CST::match(iter, TK_R_BRACE))
+            depth = max(depth - 1, 0);
+        else if (depth == 0 && (CST::match(iter, KW_FUNCTION) || CST::match(iter, KW_PROCEDURE)))
+            boundaries.push_back({iter, lines, definitions++});
+    }
+    uint32_t partTokens = max(MIN_PART_TOKENS, (uint32_t) ((iter.index() - head.index()) / count));
+
+    parts.emplace_back();
+    parts.back().start = head;
+    parts.back().lineNum = lineNum;
+    parts.back().prevScope = prevScope;
+    for (const boundary& at : boundaries)
+    {
+        if (at.start.index() - parts.back().start.index() < partTokens)
+            continue;
+        parts.back().end = at.start.index();
+        parts.emplace_back();
+        parts.back().start = at.start;
+        parts.back().lineNum = at.lineNum;
+        parts.back().prevScope = at.prevScope;
+    }
+}
+
+
+/***
+ * This parses the functions and procedures of a program at the same time on the thread
+ * pool. Each part has its own parser and symbol table, the calling thread merges the
+ * parts in source order while they are parsed (see mergeParts)
+ *
+ * @param iter the iterator node for the token list (left where the merged parts end)
+ * @param diag gets the errors
+ * @param parent root node of the CST
+ * @param _node last node of the CST
+ */
+void CST::parseInParallel(tokenIter& iter, diagnostics& diag, node *& parent, node *& _node)
+{
+    deque<programPart> parts;
+    splitProgram(parts, iter, lineNum, prevScope, pool->size() * PARTS_PER_THREAD);
+    // a stream that ended at a lex error is left for parseDeclarations to stop on
+    if (parts.size() < 2 || iter.owner()->failed())
+        return;
+
+    for (programPart& part : parts)
+    {
+        part.table = make_unique<symbolTable>();
+        part.parser.reset(new CST(part.table.get(), part.lineNum, part.prevScope, &part));
+        part.stop = part.start;
+    }
+
+    pool->run(parts.size(), [&parts](size_t idx)
+    {
+        programPart& part = parts[idx];
+        partCancelled = &part.cancelled;
+        try
+        {
+            stopIfCancelled(part.stop);
+            part.parser->parseDeclarations(part.stop, part.errors, part.root, part.last, part.end);
+        }
+        catch (const parseCancelled&) {}
+        partCancelled = nullptr;
+
+        {
+            lock_guard<mutex> guard(part.lock);
+            part.finished = true;
+        }
+        part.changed.notify_all();
+    }, [&] { mergeParts(parts, iter, diag, parent, _node); });
+}
 
+
+/***
+ * This merges the parts of a program in source order, a part's symbols and errors are
+ * added as if it had been parsed here. A part is only used if it starts where the parts
+ * before it left off (same token, line number and scope) and the lookups it made get
+ * the same answers from the whole symbol table. Its lookups are checked while it is
+ * parsed, once one does not fit it and the parts after it are cancelled and the rest of
+ * the program is left for parseDeclarations, so the result is the same as a serial parse
+ *
+ * @param parts the parts
+ * @param iter the iterator node for the token list (left where the merged parts end)
+ * @param diag gets the errors
+ * @param parent root node of the CST
+ * @param _node last node of the CST
+ */
+void CST::mergeParts(deque<programPart>& parts, tokenIter& iter, diagnostics& diag, node *& parent, node *& _node)
+{
+    priorSymbols prior;
+    size_t idx = 0;
+    for (; idx < parts.size(); idx++)
+    {
+        programPart& part = parts[idx];
+        if (part.start.index() != iter.index() || part.lineNum != lineNum || part.prevScope != prevScope)
+            break;
+
+        // wait for the part, checking its lookups as they are made
+        bool fits = true;
+        size_t checked = 0;
+        {
+            unique_lock<mutex> guard(part.lock);
+            while ((fits = prior.agreeWith(part.queries, checked)) && !part.finished)
+                part.changed.wait(guard);
+        }
+        if (!fits)
+            break;
+
+        CST& parser = *part.parser;
+        prior.add(part.table->head());
+        ST->append(part.table.get());
+        diag.append(part.errors);
+        errorDetected = errorDetected || parser.errorDetected;
+        lineNum = parser.lineNum;
+        prevScope = parser.prevScope;
+        curFunction = parser.curFunction;
+        iter = part.stop;
+
+        addPart(parent, _node, part.root, part.last, parser.firstStartsLine);
+        // the nodes are in the part parser's arena
+        if (!direct)
+            partParsers.push_back(std::move(part.parser));
+    }
+
+    for (; idx < parts.size(); idx++)
+        parts[idx].cancelled = true;
+}
+
+
+/***
+ * This links a part of the program after the declarations before it, the same way
+ * parseDeclarations links a declaration
+ *
+ * @param parent root node of the CST
+ * @param _node last node of the CST
+ * @param root first node of the part
+ * @param last last node of the part
+ * @param isChild true if the first declaration of the part began a new line
+ */
+void CST::addPart(node *& parent, node *& _node, node * root, node * last, bool isChild)
+{
+    if (!root)
+        return;
+
+    if (direct)
+        buildAST(tree.append(root, last, isChild));
+    else if (isChild)
+        insertChild(parent, _node, root, last);
+    else
+        insertSibling(parent, _node, root, last);
+}
+
+
+/***
+ * This logs a symbol table lookup when parsing part of a program, the merge checks it
+ * against the parts before it
+ *
+ * @param query the lookup and its answer
+ */
+void CST::logQuery(const symbolQuery& query)
+{
+    if (!part)
+        return;
+    {
+        lock_guard<mutex> guard(part->lock);
+        part->queries.push_back(query);
+    }
+    part->changed.notify_all();
+}
+
+
+/***
+ * This checks if a variable's name is already used (see symbolTable::inUse)
+ *
+ * @param variable the variable
+ * @param foundScope set to the scope of the variable with the name
+ * @return true if the name is in use
+ */
+bool CST::inUse(stNode * variable, int& foundScope)
+{
+    bool found = ST->inUse(variable, foundScope);
+    logQuery({SQ_IN_USE, variable->name(), variable->isArr(), found, found ? foundScope : 0});
+    return found;
+}
+
+
+/***
+ * This checks if a variable can be referenced in the current scope (see
+ * symbolTable::exists)
+ *
+ * @param variableName name of the variable
+ * @return true if it can
+ */
+bool CST::exists(internedString variableName)
+{
+    bool found = ST->exists(variableName, curScope);
+    logQuery({SQ_EXISTS, variableName, false, found, 0});
+    return found;
+}
+
+
+/***
+ * This checks if a name referenced with an index is a variable (or function) that is
+ * not an array
+ *
+ * @param variableName the name
+ * @return true if it can not be indexed
+ */
+bool CST::notIndexable(internedString variableName)
+{
+    stNode * symbolNode = ST->retrieveNode(variableName, curScope);
+    bool scalar = symbolNode && !symbolNode->isArr();
+    logQuery({SQ_NOT_INDEXABLE, variableName, false, scalar, 0});
+    return scalar;
+}
+
+
+/***
+ * This adds a parameter list to the symbol table. A part's table does not know which
+ * function node the whole program's table adds the list to, so the list is only linked
+ * (symbolTable::append adds it when the part is merged, and a session adds a piece's
+ * lists when it links the piece)
+ *
+ * @param PL the parameter list
+ */
+void CST::addParamList(symbolTable * PL)
+{
+    if (linkParamLists)
+        ST->appendST(PL);
+    else
+        ST->insertST(PL);
 }
 
 
@@ -243,69 +774,76 @@ node * CST::parse(token *& iter, ofstream& outFS) {
  * This parses a single quote string
  *
  * @param iter the current node in the token list
- * @param outFS the file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the CST structured string (if formatted correctly)
  */
-node * CST::parseSingleQuoteString(token *& iter, ofstream& outFS)
+node * CST::parseSingleQuoteString(tokenIter& iter, diagnostics& diag, node *& last)
 {
     // ensure the current node is not null
     if (!iter)
+    {
+        last = nullptr;
         return nullptr;
+    }
 
     int origLineNum = lineNum;
     // check if the statement starts with a single quote
-    if (!matchType(iter, "SINGLE_QUOTE"))
+    if (!matchType(iter, TK_SINGLE_QUOTE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED SINGLE QUOTE\n";
+        diag.report(DG_EXPECTED_SINGLE_QUOTE, lineNum);
     }
 
     // create a node for the opening quote
-    auto * parent = new node("\'", curScope);
+    auto * parent = nodes.make<node>("\'", curScope);
     node * _node = parent;
     iter = iter->next();
 
     // ensure that the string follows the structure of an empty/non-empty string
-    if (!matchType(iter, STRING) && !matchType(iter, STRING) &&
-        !matchType(iter, "SINGLE_QUOTE"))
+    if (!matchType(iter, TK_STRING) && !matchType(iter, TK_STRING) &&
+        !matchType(iter, TK_SINGLE_QUOTE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED STRING/END QUOTE\n";
+        diag.report(DG_EXPECTED_STRING_OR_END_QUOTE, lineNum);
     }
 
     // if the string is not empty, create a node for the inside string and insert it
-    if (matchType(iter, STRING)) {
-        auto *child = new node(iter->content(), curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+    if (matchType(iter, TK_STRING)) {
+        auto *child = makeLiteral(iter);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
     }
     // ensure there is a closing quote for the string
-    if (!match(iter, "\'"))
+    if (!match(iter, TK_SINGLE_QUOTE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED END QUOTE\n";
+        diag.report(DG_EXPECTED_END_QUOTE, lineNum);
     }
 
     // create a node for the ending quote
-    auto * child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    auto * child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     // iterate past the end quote
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
 
 /***
- * This parses past the end line token
+ * This parses past the end line token, no token before the next line is read
+ * again after this (a token stream can drop them)
  * @param iter the current node in the token list
  */
-void CST::parseEndlToken(token *& iter) {
+void CST::parseEndlToken(tokenIter& iter) {
 
     while (iter && iter->isEndlToken()) {
         if (iter->isEndlToken())
             lineNum++;
         iter = iter->next();
     }
+    iter->release();
 
 }
 
@@ -316,7 +854,7 @@ void CST::parseEndlToken(token *& iter) {
  *
  * @param iter current node in the token list
  */
-void CST::parseUntilEndl(token *& iter)
+void CST::parseUntilEndl(tokenIter& iter)
 {
     // iterate past all the tokens until the end line
     while (iter && !iter->isEndlToken())
@@ -328,64 +866,66 @@ void CST::parseUntilEndl(token *& iter)
  * This parses an assignment statement
  *
  * @param iter the current node in the token list
- * @param outFS the file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return the root node of the assignment statement structure
  */
-node * CST::parseAssignmentStatement(token *& iter, ofstream& outFS)
+node * CST::parseAssignmentStatement(tokenIter& iter, diagnostics& diag, node *& last)
 {
 
     int origLineNum = lineNum;
     // ensure the statement starts with an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected identifier\n";
+        diag.report(DG_EXPECTED_IDENTIFIER, lineNum);
     }
 
     // create the parent node with the identifier
-    auto * parent = new node(iter->content(), curScope);
-    string variableName = iter->content(); // used to reference the symbol table
-    node * child, * _node = parent;
+    auto * parent = nodes.make<node>(iter, curScope);
+    internedString variableName = iter->name(); // used to reference the symbol table
+    node * child, * tail, * _node = parent;
     iter = iter->next();
 
     // check if you are referencing an index
-    if (match(iter, "[")) {
-        parseBracket(iter, outFS, parent, child, _node, variableName, origLineNum);
+    if (match(iter, TK_L_BRACKET)) {
+        parseBracket(iter, diag, parent, child, _node, variableName, origLineNum);
     }
 
     // ensure there is an assignment operator in the expression
-    if (!match(iter, "="))
+    if (!match(iter, TK_ASSIGNMENT_OPERATOR))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected ASSIGNMENT OPERATOR\n";
+        diag.report(DG_EXPECTED_ASSIGNMENT, lineNum);
     }
 
     // catch the assignment operator
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // create a child node from the expression after the assigment
-    child = parseExpression(iter, outFS);
+    child = parseExpression(iter, diag, tail);
 
     // insert the child node from the expression
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    insert(parent, _node, child, tail, origLineNum);
 
     // ensure the line ends with a semicolon
-    if (!match(iter, ";"))
+    if (!match(iter, TK_SEMICOLON))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected SEMICOLON\n";
+        diag.report(DG_EXPECTED_SEMICOLON, lineNum);
     }
 
     // catch the semicolon
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // parse until next actual node
     parseEndlToken(iter);
 
+    last = _node;
     return parent;
 
 }
@@ -395,39 +935,41 @@ node * CST::parseAssignmentStatement(token *& iter, ofstream& outFS)
  * This function parses an increment statement (used in for loops)
  *
  * @param iter current node in token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the increment statement
  */
-node * CST::parseIncrementStatement(token *& iter, ofstream& outFS)
+node * CST::parseIncrementStatement(tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // ensure statement starts with an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected identifier\n";
+        diag.report(DG_EXPECTED_IDENTIFIER, lineNum);
     }
 
     // catch the identifier
-    auto * parent = new node(iter->content(), curScope);
-    node * child, * _node = parent;
+    auto * parent = nodes.make<node>(iter, curScope);
+    node * child, * tail, * _node = parent;
     iter = iter->next();
 
     // check for assigment operator
-    if (!match(iter, "="))
+    if (!match(iter, TK_ASSIGNMENT_OPERATOR))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected ASSIGNMENT OPERATOR\n";
+        diag.report(DG_EXPECTED_ASSIGNMENT, lineNum);
     }
 
     // catch assigment operator
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // catch the expression after the assignment operator
-    child = parseExpression(iter, outFS);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = parseExpression(iter, diag, tail);
+    insert(parent, _node, child, tail, origLineNum);
+    last = _node;
     return parent;
 
 }
@@ -437,49 +979,51 @@ node * CST::parseIncrementStatement(token *& iter, ofstream& outFS)
  * This function parses a double quote string
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the DQS
  */
-node * CST::parseDoubleQuoteString(token *& iter, ofstream& outFS) {
+node * CST::parseDoubleQuoteString(tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     // ensure the statement starts with a double quote
-    if (!match(iter, "\""))
+    if (!match(iter, TK_DOUBLE_QUOTE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED DOUBLE QUOTE\n";
+        diag.report(DG_EXPECTED_DOUBLE_QUOTE, lineNum);
     }
 
     // catch the double quote
-    auto * parent = new node(iter->content(), curScope);
-    node * _node = getLastNode(parent);
+    auto * parent = nodes.make<node>(iter, curScope);
+    node * _node = parent;
     iter = iter->next();
 
     // ensure that the string follows the structure of empty/non-empty strings
-    if (!matchType(iter, STRING) && !matchType(iter, "DOUBLE_QUOTE"))
+    if (!matchType(iter, TK_STRING) && !matchType(iter, TK_DOUBLE_QUOTE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED DOUBLE STRING/END QUOTE\n";
+        diag.report(DG_EXPECTED_DOUBLE_STRING_OR_END_QUOTE, lineNum);
     }
 
     // if the string is non-empty
-    if (matchType(iter, STRING))
+    if (matchType(iter, TK_STRING))
     {
         // catch the contained string and insert it
-        auto *child = new node(iter->content(), curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        auto *child = makeLiteral(iter);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
     }
     // ensure there is a closing quote
-    if (!match(iter, "\""))
+    if (!match(iter, TK_DOUBLE_QUOTE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": NO ENDING DOUBLE QUOTE\n";
+        diag.report(DG_NO_ENDING_DOUBLE_QUOTE, lineNum);
     }
     // catch closing quote
-    auto * child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    auto * child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 
 }
@@ -490,24 +1034,26 @@ node * CST::parseDoubleQuoteString(token *& iter, ofstream& outFS) {
  * parsing function
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return
  */
-node* CST::parseCompoundStatement( token *& iter, ofstream& outFS) {
+node* CST::parseCompoundStatement( tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     node* parent = nullptr;
     node* _node = parent;
-    node * child = nullptr;
+    node * child = nullptr, * tail;
 
     // iterate while there are statements in the brackets
-    while (iter && iter->content()!= "}") {
+    while (iter && !match(iter, TK_R_BRACE)) {
         // catch the statement and insert it
-        child = parseStatement(iter, outFS);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = parseStatement(iter, diag, tail);
+        insert(parent, _node, child, tail, origLineNum);
         parseEndlToken(iter);
     }
     // return the end structure
+    last = _node;
     return parent;
 }
 
@@ -516,46 +1062,48 @@ node* CST::parseCompoundStatement( token *& iter, ofstream& outFS) {
  * This parses block statements for conditionals, functions, and loops
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the block statement
  */
-node* CST::parseBlockStatement( token *& iter, ofstream& outFS) {
+node* CST::parseBlockStatement( tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     // ensure the statement begins with a left bracket
-    if (!match(iter, "{"))
+    if (!match(iter, TK_L_BRACE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected '{' to start block\n";
+        diag.report(DG_EXPECTED_BLOCK_START, lineNum);
     }
 
     // catch beginning bracket and initialize other pointers
-    node* parent = new node(iter->content(), curScope);
+    node* parent = nodes.make<node>(iter, curScope);
     node* _node = parent;
-    node* child = nullptr;
+    node* child = nullptr, * tail;
     iter = iter->next();
 
     // parse to next actual token
     parseEndlToken(iter);
 
     // parse the statements contained in the brackets
-    node* body = parseCompoundStatement(iter, outFS);
-    insert(parent, _node, body, getLastNode(body), origLineNum);
+    node* body = parseCompoundStatement(iter, diag, tail);
+    insert(parent, _node, body, tail, origLineNum);
 
     // parse to next actual token
     parseEndlToken(iter);
 
     // ensure there is a closing bracket after the statements
-    if (!match(iter, "}"))
+    if (!match(iter, TK_R_BRACE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected '}' to close block\n";
+        diag.report(DG_EXPECTED_BLOCK_END, lineNum);
     }
 
     // catch closer bracket and return
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
@@ -565,65 +1113,75 @@ node* CST::parseBlockStatement( token *& iter, ofstream& outFS) {
  * helper function to be called
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return
  */
-node* CST::parseStatement(token *& iter, ofstream& outFS) {
+node* CST::parseStatement(tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     // ensure the iterator is not null
     if (!iter)
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Statement expected but pointer is null\n";
+        diag.report(DG_NULL_STATEMENT, lineNum);
     }
     // conditional statement
-    if (match(iter, "if"))
+    if (match(iter, KW_IF))
     {
-        return parseSelectionStatement(iter, outFS);
+        return parseSelectionStatement(iter, diag, last);
     }
     // block statement
-    else if (match(iter, "{"))
+    else if (match(iter, TK_L_BRACE))
     {
-        return parseBlockStatement(iter, outFS);
+        return parseBlockStatement(iter, diag, last);
     }
     // iteration statement
-    else if (match(iter,  "while") ||
-             match(iter,  "for"))
+    else if (match(iter, KW_WHILE) ||
+             match(iter, KW_FOR))
     {
-        return parseIterationStatement(iter, outFS);
+        return parseIterationStatement(iter, diag, last);
     }
     // return statement
-    else if (match(iter,  "return"))
+    else if (match(iter, KW_RETURN))
     {
-        return parseReturnStatement(iter, outFS);
+        return parseReturnStatement(iter, diag, last);
     }
     // printf statement
-    else if (match(iter,  "printf")) {
-        return parsePrintfStatement(iter, outFS);
+    else if (match(iter, KW_PRINTF)) {
+        return parsePrintfStatement(iter, diag, last);
     }
     // get char statement
-    else if (match(iter,  "getChar")) {
-        return parseGetCharFunction(iter, outFS);
+    else if (match(iter, GET_CHAR_STATEMENT)) {
+        return parseGetCharFunction(iter, diag, last);
     }
     // declaration statement
     else if (isDatatype(iter)) {
-        return parseDeclarationStatement(iter, outFS);
+        return parseDeclarationStatement(iter, diag, last);
     }
     // begins with identifier, either assigment or user function
-    else if (matchType(iter, IDENTIFIER)) {
-        token * peek = iter->next();
-        if (match(peek, "=") || match(peek, "["))
-            return parseAssignmentStatement(iter, outFS);
+    else if (matchType(iter, TK_IDENTIFIER)) {
+        tokenIter peek = iter->next();
+        if (match(peek, TK_ASSIGNMENT_OPERATOR) || match(peek, TK_L_BRACKET))
+            return parseAssignmentStatement(iter, diag, last);
         else
-            return parseUserDefinedFunctionStatement(iter, outFS);
+            return parseUserDefinedFunctionStatement(iter, diag, last);
     }
     // current node is an end line token, parse past it and return based off next token
-    else
+    else if (iter && iter->isEndlToken())
     {
         parseEndlToken(iter);
-        return parseStatement(iter, outFS);
+        return parseStatement(iter, diag, last);
+    }
+    // no statement starts with this token, skip the rest of its line so the parse moves on
+    else if (iter)
+    {
+        errorDetected = true;
+        diag.report(DG_INVALID_STATEMENT, lineNum);
+        parseUntilEndl(iter);
     }
+    last = nullptr;
+    return nullptr;
 }
 
 
@@ -631,139 +1189,145 @@ node* CST::parseStatement(token *& iter, ofstream& outFS) {
  * This function parses a printf function call
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the statement
  */
-node* CST::parsePrintfStatement( token *& iter, ofstream& outFS) {
+node* CST::parsePrintfStatement( tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     // ensure the statement begins with "printf"
-    if (!match(iter, "printf"))
+    if (!match(iter, KW_PRINTF))
     {
-        errorDetected = true; outFS << "Syntax error on line " << lineNum << ": Expected 'printf'\n";
+        errorDetected = true; diag.report(DG_EXPECTED_PRINTF, lineNum);
     }
 
     // catch printf
-    node* parent = new node(iter->content(), curScope);
+    node* parent = nodes.make<node>(iter, curScope);
     node* _node = parent;
-    node* child = nullptr;
+    node* child = nullptr, * tail;
     iter = iter->next();
 
     // make sure there is a parentheses after printf
-    if (!match(iter, "("))
+    if (!match(iter, TK_L_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected '(' after 'printf'\n";
+        diag.report(DG_EXPECTED_PRINTF_OPEN, lineNum);
     }
     // catch left parentheses
-    child = new node("(", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>("(", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // check the type of string
     // double quote string
-    if (match(iter, "\"")) {
-        child = parseDoubleQuoteString(iter, outFS);
+    if (match(iter, TK_DOUBLE_QUOTE)) {
+        child = parseDoubleQuoteString(iter, diag, tail);
     }
     // single quote string
-    else if (match(iter, "'")) {
-        child = parseSingleQuoteString(iter, outFS);
+    else if (match(iter, TK_SINGLE_QUOTE)) {
+        child = parseSingleQuoteString(iter, diag, tail);
     }
     // current token is not a string
     else {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected a quoted string after printf\n";
+        diag.report(DG_EXPECTED_PRINTF_STRING, lineNum);
     }
-    insert(parent,_node, child, getLastNode(child), origLineNum);
+    insert(parent,_node, child, tail, origLineNum);
 
     // check if there are variable parameters after the string
-    if (match(iter, ","))
+    if (match(iter, TK_COMMA))
     {
         // catch initial comma
-        child = new node(iter->content(), curScope);
+        child = nodes.make<node>(iter, curScope);
         insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
         // catch the parameters
-        node* args = parseIdentifierAndIdentifierArrayList(iter, outFS);
-        insert(parent,_node, args, getLastNode(args), origLineNum);
+        node* args = parseIdentifierAndIdentifierArrayList(iter, diag, tail);
+        insert(parent,_node, args, tail, origLineNum);
     }
 
     // check for ending right parentheses
-    if (!match(iter, ")"))
+    if (!match(iter, TK_R_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected ')' after printf arguments\n";
+        diag.report(DG_EXPECTED_PRINTF_CLOSE, lineNum);
     }
     // catch ending parentheses
-    child = new node(")",curScope);
+    child = nodes.make<node>(")",curScope);
     insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // ensure there is an ending semicolon
-    if (!match(iter, ";"))
+    if (!match(iter, TK_SEMICOLON))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected ';' after printf statement\n";
+        diag.report(DG_EXPECTED_PRINTF_SEMICOLON, lineNum);
     }
     // catch semicolon
-    child = new node(iter->content(), curScope);
+    child = nodes.make<node>(iter, curScope);
     insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
 
-node * CST::parseBracket( token *& iter, ofstream &outFS, node *& parent, node *& child, node *& _node,
-                          const string& variableName, const int& origLineNum)
+node * CST::parseBracket( tokenIter& iter, diagnostics& diag, node *& parent, node *& child, node *& _node,
+                          internedString variableName, const int& origLineNum)
 {
-    stNode * symbolNode = ST->retrieveNode(variableName, curScope);
     // check if a non-array variable is being referenced with an index
-    if (symbolNode && !symbolNode->isArr())
+    if (notIndexable(variableName))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Attempted to reference an index of a non-array variable\n";
-        delete parent;
+        diag.report(DG_INDEX_OF_NON_ARRAY, lineNum);
         parseUntilEndl(iter); // parse to the end line
         parseEndlToken(iter); // parse until actual token
         return nullptr;
     }
     // catch the initial bracket
-    child = new node(iter->content(), curScope);
+    child = nodes.make<node>(iter, curScope);
     insert(parent, _node, child, child, origLineNum);
 
     iter = iter->next();
 
     // ensure that the size variable is an integer
-    if (!matchType(iter, INTEGER) && !(matchType(iter, IDENTIFIER)))
+    if (!matchType(iter, TK_INTEGER) && !(matchType(iter, TK_IDENTIFIER)))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected array index as integer\n";
+        diag.report(DG_EXPECTED_INTEGER_INDEX, lineNum);
     }
     else
     {
         // check if the current token is a negative integer if it is an integer
-        if (matchType(iter, INTEGER) && iter->content()[0] == '-')
+        if (matchType(iter, TK_INTEGER) && iter->content()[0] == '-')
         {
             errorDetected = true;
-            outFS << "Syntax error on line " << lineNum << ": Expected array index to be a positive integer\n";
+            diag.report(DG_NEGATIVE_INDEX, lineNum);
+        }
+        // check if the integer is too large to be an index
+        else if (!iter->valueInRange())
+        {
+            errorDetected = true;
+            diag.report(DG_INDEX_TOO_LARGE, lineNum);
         }
     }
 
-    // create a node for the size variable/integer
-    child = new node(iter->content(), curScope);
+    // create a node for the size variable/integer (integers keep their decoded value)
+    child = nodes.make<node>(iter, curScope);
     insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // ensure there is a closing bracket
-    if (!match(iter, "]"))
+    if (!match(iter, TK_R_BRACKET))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected closing ']' for array declaration\n";
+        diag.report(DG_EXPECTED_INDEX_CLOSE, lineNum);
     }
 
     // catch closing bracket
-    child = new node(iter->content(), curScope);
+    child = nodes.make<node>(iter, curScope);
     insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
     return parent;
@@ -774,58 +1338,59 @@ node * CST::parseBracket( token *& iter, ofstream &outFS, node *& parent, node *
  * This function parses a list of identifiers for function calls, printf statements, etc
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the list
  */
-node* CST::parseIdentifierAndIdentifierArrayList( token *& iter, ofstream& outFS) {
+node* CST::parseIdentifierAndIdentifierArrayList( tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     // ensure the statement begins with an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected identifier\n";
+        diag.report(DG_EXPECTED_IDENTIFIER, lineNum);
     }
 
     // catch initial identifier
-    node* parent = new node(iter->content(), curScope);
-    string variableName = iter->content();
-    node* _node = getLastNode(parent);
+    node* parent = nodes.make<node>(iter, curScope);
+    internedString variableName = iter->name();
+    node* _node = parent;
     node* child;
     iter = iter->next();
 
     // ensure variable exists in the scope
-    if (!ST->exists(variableName, curScope))
+    if (!exists(variableName))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": unknown variable referenced\n";
+        diag.report(DG_UNKNOWN_VARIABLE, lineNum);
     }
 
     while (iter) {
 
         // current parameter is an array
-        if (match(iter, "[")) {
-            parseBracket(iter, outFS, parent, child, _node, variableName, origLineNum);
+        if (match(iter, TK_L_BRACKET)) {
+            parseBracket(iter, diag, parent, child, _node, variableName, origLineNum);
         }
 
         // check if there are additional parameters
-        if (match(iter, ","))
+        if (match(iter, TK_COMMA))
         {
             // catch comma
-            child = new node(iter->content(), curScope);
-            insert(parent, _node, child, getLastNode(child), origLineNum);
+            child = nodes.make<node>(iter, curScope);
+            insert(parent, _node, child, child, origLineNum);
             iter = iter->next();
 
             // ensure there is an identifier after the comma
-            if (!matchType(iter, IDENTIFIER))
+            if (!matchType(iter, TK_IDENTIFIER))
             {
                 errorDetected = true;
-                outFS << "Syntax error on line " << lineNum << ": NO IDENTIFIER AFTER COMMA\n";
+                diag.report(DG_NO_IDENTIFIER_AFTER_COMMA, lineNum);
             }
 
             // catch the identifier
-            child = new node(iter->content(), curScope);
-            insert(parent, _node, child, getLastNode(child), origLineNum);
+            child = nodes.make<node>(iter, curScope);
+            insert(parent, _node, child, child, origLineNum);
             iter = iter->next();
 
         }
@@ -835,6 +1400,7 @@ node* CST::parseIdentifierAndIdentifierArrayList( token *& iter, ofstream& outFS
         }
     }
 
+    last = _node;
     return parent;
 }
 
@@ -843,55 +1409,56 @@ node* CST::parseIdentifierAndIdentifierArrayList( token *& iter, ofstream& outFS
  * This function parses an iteration statement (for/while loop)
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the iteration statement
  */
-node* CST::parseIterationStatement( token *& iter, ofstream& outFS) {
+node* CST::parseIterationStatement( tokenIter& iter, diagnostics& diag, node *& last) {
 
     int origLineNum = lineNum;
     // ensure the pointer is not null
     if (!iter)
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Unexpected end of input in iteration statement\n";
+        diag.report(DG_ITERATION_END_OF_INPUT, lineNum);
     }
 
     // initialize node pointers
     node* parent = nullptr;
     node* _node = parent;
-    node* child = nullptr;
+    node* child = nullptr, * tail;
 
     // check if it is a while loop
-    if (match(iter, "while"))
+    if (match(iter, KW_WHILE))
     {
         // catch the while
-        parent = new node("while", curScope);
+        parent = nodes.make<node>("while", curScope);
         _node = parent;
         iter = iter->next();
 
         // ensure there is a parentheses after while
-        if (!match(iter, "("))
+        if (!match(iter, TK_L_PAREN))
         {
             errorDetected = true;
-            outFS << "Syntax error on line " << lineNum << ": Expected '(' after 'while'\n";
+            diag.report(DG_EXPECTED_WHILE_OPEN, lineNum);
         }
 
         // catch left parentheses
-        child = new node("(", curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = nodes.make<node>("(", curScope);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
         // catch the condition
-        node* condition = parseBooleanExpression(iter, outFS);
-        insert(parent,_node, condition, getLastNode(condition), origLineNum);
+        node* condition = parseBooleanExpression(iter, diag, tail);
+        insert(parent,_node, condition, tail, origLineNum);
 
-        if (!match(iter, ")"))
+        if (!match(iter, TK_R_PAREN))
         {
-            errorDetected = true; outFS << "Syntax error on line " << lineNum << ": Expected ')' after while condition\n";}
+            errorDetected = true; diag.report(DG_EXPECTED_WHILE_CLOSE, lineNum);}
 
         // catch ending parentheses
-        child = new node(")", curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = nodes.make<node>(")", curScope);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
         // reset line flag variable and parse to next token
@@ -899,75 +1466,78 @@ node* CST::parseIterationStatement( token *& iter, ofstream& outFS) {
         parseEndlToken(iter);
 
         // insert the statements in the loop and return
-        node* stmt = parseStatement(iter, outFS);
-        insert(parent,_node, stmt, getLastNode(stmt), origLineNum);
+        node* stmt = parseStatement(iter, diag, tail);
+        insert(parent,_node, stmt, tail, origLineNum);
+        last = _node;
         return parent;
     }
     // check for "for" loop
-    else if (match(iter, "for"))
+    else if (match(iter, KW_FOR))
     {
         // catch for
-        parent = new node("for", curScope);
+        parent = nodes.make<node>("for", curScope);
         _node = parent;
         iter = iter->next();
 
         // ensure there is a left parentheses after for
-        if (!match(iter, "("))
+        if (!match(iter, TK_L_PAREN))
         {
             errorDetected = true;
-            outFS << "Syntax error on line " << lineNum << ": Expected '(' after 'for'\n";
+            diag.report(DG_EXPECTED_FOR_OPEN, lineNum);
         }
 
         // catch left parentheses
-        child = new node("(", curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = nodes.make<node>("(", curScope);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
         // catch initialization expression
-        node* init = parseAssignmentStatement(iter, outFS);
-        insert(parent, _node, init, getLastNode(init), origLineNum);
+        node* init = parseAssignmentStatement(iter, diag, tail);
+        insert(parent, _node, init, tail, origLineNum);
 
         // catch the condition
-        node* condition = parseBooleanExpression(iter, outFS);
-        insert(parent,_node, condition, getLastNode(condition),origLineNum);
+        node* condition = parseBooleanExpression(iter, diag, tail);
+        insert(parent,_node, condition, tail,origLineNum);
 
         // ensure there is a semicolon after
-        if (!match(iter, ";"))
+        if (!match(iter, TK_SEMICOLON))
         {
             errorDetected = true;
-            outFS << "Syntax error on line " << lineNum << ": Expected second ';' in for-loop\n";
+            diag.report(DG_EXPECTED_FOR_SEMICOLON, lineNum);
         }
         // catch semicolon
-        child = new node(";", curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = nodes.make<node>(";", curScope);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
         // catch increment statement
-        node* update = parseIncrementStatement(iter, outFS);
-        insert(parent,_node, update, getLastNode(update),origLineNum);
+        node* update = parseIncrementStatement(iter, diag, tail);
+        insert(parent,_node, update, tail,origLineNum);
 
         // check for ending parentheses
-        if (!match(iter, ")"))
+        if (!match(iter, TK_R_PAREN))
         {
             errorDetected = true;
-            outFS << "Syntax error on line " << lineNum << ": Expected ')' after for-loop header\n";
+            diag.report(DG_EXPECTED_FOR_CLOSE, lineNum);
         }
         // catch ending parentheses
-        child = new node(")", curScope);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = nodes.make<node>(")", curScope);
+        insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
         // consume and insert statements within the bounds of the for loop
-        node* stmt = parseStatement(iter, outFS);
-        insert(parent,_node, stmt, getLastNode(stmt), origLineNum);
+        node* stmt = parseStatement(iter, diag, tail);
+        insert(parent,_node, stmt, tail, origLineNum);
+        last = _node;
         return parent;
     }
     // invalid iteration statement
     else
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected 'for' or 'while' at start of iteration statement\n";
+        diag.report(DG_EXPECTED_ITERATION, lineNum);
     }
+    last = nullptr;
     return nullptr;
 }
 
@@ -976,38 +1546,40 @@ node* CST::parseIterationStatement( token *& iter, ofstream& outFS) {
  * This function parses a return statement
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the return statement
  */
-node* CST::parseReturnStatement( token *& iter, ofstream& outFS)
+node* CST::parseReturnStatement( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // ensure the statement begins with return
-    if (!match(iter, "return"))
+    if (!match(iter, KW_RETURN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected 'return'\n";
+        diag.report(DG_EXPECTED_RETURN, lineNum);
     }
     // catch return
-    node* parent = new node(iter->content(), curScope);
-    node* _node = parent, *child;
+    node* parent = nodes.make<node>(iter, curScope);
+    node* _node = parent, *child, *tail;
     iter = iter->next();
 
     // parse expression
-    child = parseExpression(iter, outFS);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = parseExpression(iter, diag, tail);
+    insert(parent, _node, child, tail, origLineNum);
 
     // ensure there is a semicolon after the expression
-    if (!match(iter, ";"))
+    if (!match(iter, TK_SEMICOLON))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected ';' at end of return statement\n";
+        diag.report(DG_EXPECTED_RETURN_SEMICOLON, lineNum);
     }
 
     // catch the semicolon
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
@@ -1016,13 +1588,15 @@ node* CST::parseReturnStatement( token *& iter, ofstream& outFS)
  * This function parses a declaration statement
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the declaration statement
  */
-node * CST::parseDeclarationStatement(token *& iter, ofstream& outFS)
+node * CST::parseDeclarationStatement(tokenIter& iter, diagnostics& diag, node *& last)
 {
     // symbol table parameters
-    string idName, idType = "datatype", datatype;
+    internedString idName, datatype;
+    symbolKind idType = SK_DATATYPE;
     bool isArr = false;
     int arrSize = 0;
 
@@ -1031,52 +1605,52 @@ node * CST::parseDeclarationStatement(token *& iter, ofstream& outFS)
     if (!isDatatype(iter))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected datatype\n";
+        diag.report(DG_EXPECTED_DATATYPE, lineNum);
     }
 
     // initialize node pointers and catch datatype
-    auto *parent = new node(iter->content(), curScope);
-    datatype = iter->content();
+    auto *parent = nodes.make<node>(iter, curScope);
+    datatype = iter->name();
     node *_node = parent, *child = nullptr;
     iter = iter->next();
 
 
-    while (!match(iter, ";"))
+    // stop at the end of the program if the semicolon is missing
+    while (iter && !match(iter, TK_SEMICOLON))
     {
-        if (!matchType(iter, IDENTIFIER)) {
-            { errorDetected = true; outFS << "Syntax error on line " << lineNum << ": Expected identifier in declaration\n";}
+        if (!matchType(iter, TK_IDENTIFIER)) {
+            { errorDetected = true; diag.report(DG_EXPECTED_DECLARATION_IDENTIFIER, lineNum);}
         }
 
-        idName = iter->content();
-        node *idNode = new node(iter->content(), curScope);
-        insert(parent,_node, idNode, getLastNode(idNode),origLineNum);
+        idName = iter->name();
+        node *idNode = nodes.make<node>(iter, curScope);
+        insert(parent,_node, idNode, idNode,origLineNum);
         iter = iter->next();
 
         // check if variable is an array
-        if (match(iter, "[")) {
+        if (match(iter, TK_L_BRACKET)) {
 
             isArr = true;
-            parseBracket(iter, outFS, parent, child, _node, idName, origLineNum);
+            // record the size if it is an integer (it used to be left at 0)
+            tokenIter size = iter->next();
+            if (matchType(size, TK_INTEGER))
+                arrSize = size->value();
+            parseBracket(iter, diag, parent, child, _node, idName, origLineNum);
         }
 
         auto * variable = new stNode(idName, idType, datatype, isArr, arrSize, curScope);
         int foundScope;
         // ensure the variable name is not already used
-        if (ST->inUse(variable, foundScope))
+        if (inUse(variable, foundScope))
         {
-            outFS << "Error on line " << lineNum << ": variable \"" << idName << "\" is already defined ";
-            if (foundScope == 0)
-                outFS << "globally\n";
-            else
-                outFS << "locally\n";
+            diag.report(foundScope == 0 ? DG_DEFINED_GLOBALLY : DG_DEFINED_LOCALLY, lineNum, idName);
             errorDetected = true;
             delete variable;
         }
         // variable name is also not a reserve word
-        else if (checkReserveWord(variable->idName(), VAR_RESERVED_WORDS))
+        else if (checkReserveWord(variable->idName(), KF_VAR_RESERVED))
         {
-            outFS << "Syntax Error on line " << lineNum << ": the name " << idName << " cannot be used as it";
-            outFS << " is a reserve word\n";
+            diag.report(DG_RESERVED_VARIABLE_NAME, lineNum, idName);
             errorDetected = true;
             delete variable;
         }
@@ -1085,11 +1659,11 @@ node * CST::parseDeclarationStatement(token *& iter, ofstream& outFS)
             ST->insert(variable);
 
         // check if there are additional declarations
-        if (match(iter, ","))
+        if (match(iter, TK_COMMA))
         {
             // catch comma
-            child = new node(iter->content(), curScope);
-            insert(parent, _node, child, getLastNode(child), origLineNum);
+            child = nodes.make<node>(iter, curScope);
+            insert(parent, _node, child, child, origLineNum);
             iter = iter->next();
 
             // reset symbol table parameters
@@ -1100,15 +1674,16 @@ node * CST::parseDeclarationStatement(token *& iter, ofstream& outFS)
 
     }
     // ensure there is a semicolon after the declaration(s)
-    if (!match(iter, ";"))
+    if (!match(iter, TK_SEMICOLON))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected semicolon to end declaration statement\n";
+        diag.report(DG_EXPECTED_DECLARATION_SEMICOLON, lineNum);
     }
     // catch semicolon
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
@@ -1117,44 +1692,45 @@ node * CST::parseDeclarationStatement(token *& iter, ofstream& outFS)
  * This function parses a selection (if) statement
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the selection statement
  */
-node* CST::parseSelectionStatement( token *& iter, ofstream& outFS)
+node* CST::parseSelectionStatement( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // ensure statment begins with if
-    if (!match(iter, "if"))
+    if (!match(iter, KW_IF))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected 'if' at start of selection statement\n";
+        diag.report(DG_EXPECTED_IF, lineNum);
     }
 
     // catch if and initialize other node pointers
-    auto* parent = new node(iter->content(), curScope);
+    auto* parent = nodes.make<node>(iter, curScope);
     auto* _node = parent;
-    node * child = nullptr;
+    node * child = nullptr, * tail;
     iter = iter->next();
 
     // catch condition
-    node* condition = parseBooleanExpression(iter, outFS);
-    insert(parent,_node, condition, getLastNode(condition),origLineNum);
+    node* condition = parseBooleanExpression(iter, diag, tail);
+    insert(parent,_node, condition, tail,origLineNum);
     origLineNum = lineNum;
     parseEndlToken(iter); // parse to next actual token
 
     // catch all the statements within the if statement and insert them
-    node* stmt = parseStatement(iter, outFS);
-    insert(parent,_node, stmt, getLastNode(stmt), origLineNum);
+    node* stmt = parseStatement(iter, diag, tail);
+    insert(parent,_node, stmt, tail, origLineNum);
 
     // update line flag variable and parse to next token
     origLineNum = lineNum;
     parseEndlToken(iter);
 
     // check if there is an else
-    if (match(iter, "else")) {
+    if (match(iter, KW_ELSE)) {
 
         // catch else
-        child = new node(iter->content(), curScope);
+        child = nodes.make<node>(iter, curScope);
         insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
 
@@ -1163,10 +1739,11 @@ node* CST::parseSelectionStatement( token *& iter, ofstream& outFS)
         parseEndlToken(iter);
 
         // catch all the statements within the else statement and insert them
-        stmt = parseStatement(iter, outFS);
-        insert(parent,_node, stmt, getLastNode(stmt), origLineNum);
+        stmt = parseStatement(iter, diag, tail);
+        insert(parent,_node, stmt, tail, origLineNum);
     }
 
+    last = _node;
     return parent;
 }
 
@@ -1175,49 +1752,51 @@ node* CST::parseSelectionStatement( token *& iter, ofstream& outFS)
  * This function parses a procedure
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of procedure structure
  */
-node * CST::parseProcedureDeclaration(token *& iter, ofstream& outFS)
+node * CST::parseProcedureDeclaration(tokenIter& iter, diagnostics& diag, node *& last)
 {
     // symbol table parameters
-    string idName, idType = "procedure", datatype = "NOT APPLICABLE";
+    internedString idName, datatype; // a procedure has no data type
+    symbolKind idType = SK_PROCEDURE;
     prevScope++;
     curScope = prevScope;
 
     int origLineNum = lineNum;
     // ensure initial statement begins with procedure
-    if (!match(iter, "procedure"))
+    if (!match(iter, KW_PROCEDURE))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED PROCEDURE\n";
+        diag.report(DG_EXPECTED_PROCEDURE, lineNum);
     }
 
     // catch procedure
-    auto * parent = new node(iter->content(), curScope);
-    node * _node = getLastNode(parent);
+    auto * parent = nodes.make<node>(iter, curScope);
+    node * _node = parent, * tail;
     iter = iter->next();
 
     // ensure the name of the procedure is an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED IDENTIFIER\n";
+        diag.report(DG_EXPECTED_NAME, lineNum);
     }
 
     // set current function and id name to the name of the procedure
-    curFunction = idName = iter->content();
+    curFunction = idName = iter->name();
 
     // check if name is a reserve word
-    if (checkReserveWord(idName, FUNCTION_SPECIFIC_RESERVES))
+    if (checkReserveWord(idName.view(), KF_FUNCTION_RESERVED))
     {
-        outFS << "Syntax error on line " << lineNum << ": " << idName << " can not be used as the name of a procedure\n";
+        diag.report(DG_RESERVED_PROCEDURE_NAME, lineNum, idName);
         errorDetected = true;
     }
 
     // catch the function name
-    auto * child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    auto * child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // create a symbol table node and insert it into the symbol table
@@ -1225,50 +1804,50 @@ node * CST::parseProcedureDeclaration(token *& iter, ofstream& outFS)
     ST->insert(procedure);
 
     // ensure the procedure has a left parentheses
-    if (!match(iter, "("))
+    if (!match(iter, TK_L_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED (\n";
+        diag.report(DG_EXPECTED_PARAMETERS_OPEN, lineNum);
     }
     // catch left parentheses
-    child = new node("(", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>("(", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // catch parameter list (if it exists)
-    auto * paramList = parseParameterList(iter, outFS);
+    auto * paramList = parseParameterList(iter, diag, tail);
     // if parameter list is null, ensure it has void instead
-    if (!paramList && !match(iter, "void") )
+    if (!paramList && !match(iter, KW_VOID) )
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED void\n";
+        diag.report(DG_EXPECTED_VOID, lineNum);
     }
 
     symbolTable * PL = nullptr;
     // if there is a parameter list, insert it into the symbol table
     if (paramList) {
         child = paramList;
-        PL = createPL(paramList, outFS);
-        ST->insertST(PL);
+        PL = createPL(paramList, diag);
+        addParamList(PL);
     }
     else
-        child = new node(iter->content(), curScope);
+        child = tail = nodes.make<node>(iter, curScope);
 
     // insert parameter list/void
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    insert(parent, _node, child, tail, origLineNum);
     if (!paramList)
         iter = iter->next();
 
     // ensure there is a closing parentheses
-    if (!match(iter, ")"))
+    if (!match(iter, TK_R_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED )\n";
+        diag.report(DG_EXPECTED_PARAMETERS_CLOSE, lineNum);
     }
 
     // catch ending parentheses
-    child = new node(")", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(")", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // reset line flag
@@ -1276,8 +1855,9 @@ node * CST::parseProcedureDeclaration(token *& iter, ofstream& outFS)
     parseEndlToken(iter);
 
     // insert the block statement and return
-    child = parseBlockStatement(iter, outFS);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = parseBlockStatement(iter, diag, tail);
+    insert(parent, _node, child, tail, origLineNum);
+    last = _node;
     return parent;
 
 }
@@ -1287,48 +1867,50 @@ node * CST::parseProcedureDeclaration(token *& iter, ofstream& outFS)
  * This function parses a getChar statement
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the getChar statement
  */
-node* CST::parseGetCharFunction( token *& iter, ofstream& outFS)
+node* CST::parseGetCharFunction( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // ensure the statement begins with getChar
-    if (!match(iter, "getchar"))
+    if (!match(iter, KW_GETCHAR))
     { 
         errorDetected = true; 
-        outFS << "Syntax error on line " << lineNum << ": Expected 'getchar'\n";
+        diag.report(DG_EXPECTED_GETCHAR, lineNum);
     }
 
     // catch getChar and initialize other node pointers
-    node* parent = new node(iter->content(), curScope);
-    node* _node = getLastNode(parent);
+    node* parent = nodes.make<node>(iter, curScope);
+    node* _node = parent;
     node* child;
     iter = iter->next();
 
     // check for left parentheses
-    if (!match(iter, "("))
+    if (!match(iter, TK_L_PAREN))
     {
         errorDetected = true; 
-        outFS << "Syntax error on line " << lineNum << ": Expected '(' after 'getchar'\n";
+        diag.report(DG_EXPECTED_GETCHAR_OPEN, lineNum);
     }
 
     // catch left parentheses
-    child = new node("(", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>("(", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // check for ending parentheses
-    if (!match(iter, ")"))
+    if (!match(iter, TK_R_PAREN))
     { 
         errorDetected = true; 
-        outFS << "Syntax error on line " << lineNum << ": Expected ')' after 'getchar()'\n";
+        diag.report(DG_EXPECTED_GETCHAR_CLOSE, lineNum);
     }
 
     // catch ending parentheses
-    child = new node(")", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(")", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
@@ -1338,11 +1920,9 @@ node* CST::parseGetCharFunction( token *& iter, ofstream& outFS)
  * @param iter current node in the token list
  * @return true if iter contains a boolean operator, false if not
  */
-bool CST::isBooleanOperator(token *&iter) {
+bool CST::isBooleanOperator(tokenIter& iter) {
 
-    return (iter && (iter->content() == "<=" || iter->content() == ">=" || iter->content() == "!" ||
-                    iter->content() == "==" || iter->content() == "<" || iter->content()== ">" ||
-                    iter->content() == "&&" || iter->content() == "!=" || iter->content()== "||"));
+    return iter && BOOLEAN_OPERATOR[punctuatorKind(iter->name().id())];
 
 }
 
@@ -1351,51 +1931,54 @@ bool CST::isBooleanOperator(token *&iter) {
  * This parses a parameter list
  * 
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the parameter list
  */
-node * CST::parseParameterList(token *& iter, ofstream& outFS)
+node * CST::parseParameterList(tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // ensure the list begins with a parameter
     if (!isDatatype(iter)) {
+        last = nullptr;
         return nullptr;
     }
     
     // catch initial datatype
-    auto * parent = new node(iter->content(), curScope);
-    auto * _node = parent;
+    auto * parent = nodes.make<node>(iter, curScope);
+    node * _node = parent, * tail;
     iter = iter->next();
 
     // ensure current token is an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     { 
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED IDENTIFIER\n";
+        diag.report(DG_EXPECTED_NAME, lineNum);
     }
 
     // catch identifier
-    auto * child = new node(iter->content(), curScope);
-    string variableName = iter->content();
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    auto * child = nodes.make<node>(iter, curScope);
+    internedString variableName = iter->name();
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // check if variable is an array
-    if (match(iter, "[")) {
-        parseBracket(iter, outFS, parent, child, _node, variableName, origLineNum);
+    if (match(iter, TK_L_BRACKET)) {
+        parseBracket(iter, diag, parent, child, _node, variableName, origLineNum);
     }
 
     // check for additional parameters and insert them recursively
-    if (match(iter, ","))
+    if (match(iter, TK_COMMA))
     {
-        child = new node(iter->content(), curScope);
+        child = nodes.make<node>(iter, curScope);
         insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
-        child = parseParameterList(iter, outFS);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = parseParameterList(iter, diag, tail);
+        insert(parent, _node, child, tail, origLineNum);
 
 
     }
+    last = _node;
     return parent;
 
 }
@@ -1406,10 +1989,10 @@ node * CST::parseParameterList(token *& iter, ofstream& outFS)
  * @param iter current node in token list
  * @return if the node holds a datatype, false if not
  */
-bool CST::isDatatype(token *& iter)
+bool CST::isDatatype(tokenIter& iter)
 {
-    if (!match(iter, "char") && !match(iter, "bool")
-        && !match(iter, "int"))
+    if (!match(iter, KW_CHAR) && !match(iter, KW_BOOL)
+        && !match(iter, KW_INT))
         return false;
     return true;
 }
@@ -1419,78 +2002,79 @@ bool CST::isDatatype(token *& iter)
  * This parses a boolean expression
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the expression
  */
-node* CST::parseBooleanExpression( token *& iter, ofstream& outFS) {
+node* CST::parseBooleanExpression( tokenIter& iter, diagnostics& diag, node *& last) {
 
     // initialize pointers and line flag variable
     node* parent = nullptr;
-    node * _node = parent, * child = nullptr;
+    node * _node = parent, * child = nullptr, * tail;
     int origLineNum = lineNum;
 
     // check cases for non-boolean operators
     if (!isBooleanOperator(iter))
     {
         // expression is contained within parentheses
-        if (match(iter, "(")) {
+        if (match(iter, TK_L_PAREN)) {
 
             // catch initial parentheses
-            parent = new node("(", curScope);
+            parent = nodes.make<node>("(", curScope);
             _node = parent;
             iter = iter->next();
 
             // catch expression
-            child = parseBooleanExpression(iter, outFS);
-            insert(parent, _node, child, getLastNode(child), origLineNum);
+            child = parseBooleanExpression(iter, diag, tail);
+            insert(parent, _node, child, tail, origLineNum);
 
             // ensure there is an ending parentheses
-            if (!match(iter, ")"))
+            if (!match(iter, TK_R_PAREN))
             {
                 errorDetected = true;
-                outFS << "Syntax error on line " << lineNum << ": MISSING CLOSING PARENTHESES\n";
+                diag.report(DG_MISSING_CLOSING_PARENTHESIS, lineNum);
             }
 
             // catch ending parentheses
-            child = new node(")", curScope);
-            insert(parent, _node, child, getLastNode(child), origLineNum);
+            child = nodes.make<node>(")", curScope);
+            insert(parent, _node, child, child, origLineNum);
             iter = iter->next();
         }
         // check if condition is entirely a false or true statement
-        else if (match(iter, "TRUE") || match(iter, "FALSE"))
+        else if (match(iter, KW_TRUE) || match(iter, KW_FALSE))
         {
-            parent = new node(iter->content(), curScope);
+            parent = _node = nodes.make<node>(iter, curScope);
             iter = iter->next();
         }
         // single quote string
-        else if (match(iter, "'")) {
-            parent = parseSingleQuoteString(iter, outFS);
+        else if (match(iter, TK_SINGLE_QUOTE)) {
+            parent = parseSingleQuoteString(iter, diag, _node);
 
         }
         // double quote string
-        else if (match(iter, "\"")) {
-            parent = parseDoubleQuoteString(iter, outFS);
+        else if (match(iter, TK_DOUBLE_QUOTE)) {
+            parent = parseDoubleQuoteString(iter, diag, _node);
         }
         // numerical expression
         else {
-            parent = parseNumericalExpression(iter, outFS);
+            parent = parseNumericalExpression(iter, diag, _node);
         }
-         _node = getLastNode(parent);
     }
 
     // iterate through the rest of the expression
     while (isBooleanOperator(iter))
     {
         // catch the operator
-        node* op = new node(iter->content(), curScope);
-        insert(parent,_node, op, getLastNode(op),origLineNum);
+        node* op = nodes.make<node>(iter, curScope);
+        insert(parent,_node, op, op,origLineNum);
         iter = iter->next();
 
         // catch the rest of the expression/next term
-        node* right = parseBooleanExpression(iter, outFS);
-        insert(parent,_node, right, getLastNode(right),origLineNum);
+        node* right = parseBooleanExpression(iter, diag, tail);
+        insert(parent,_node, right, tail,origLineNum);
     }
 
+    last = _node;
     return parent;
 }
 
@@ -1499,37 +2083,38 @@ node* CST::parseBooleanExpression( token *& iter, ofstream& outFS) {
  * This creates a parameters list for the symbol table
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
  * @return the created symbol table
  */
-symbolTable * CST::createPL(node * iter, ofstream& outFS)
+symbolTable * CST::createPL(node * iter, diagnostics& diag)
 {
     // initialize base parameters
     auto * PL = new symbolTable(curFunction);
-    string idName, idType = "datatype", datatype;
+    internedString idName, datatype;
+    symbolKind idType = SK_DATATYPE;
     bool isArr = false;
     int size = 0;
 
     while (iter)
     {
         // get the datatype
-        datatype = iter->content();
+        datatype = iter->name();
         iter = iter->sibling();
 
         // get the name
-        idName = iter->content();
+        idName = iter->name();
         iter = iter->sibling();
 
         // check if array
-        if (iter && iter->content() == "[")
+        if (iter && punctuatorKind(iter->name().id()) == TK_L_BRACKET)
         {
             isArr = true;
             iter = iter->sibling();
 
             // check if a size is given
-            if (iter->content() != "]")
+            if (punctuatorKind(iter->name().id()) != TK_R_BRACKET)
             {
-                size = stoi(iter->content());
+                size = iter->value();
                 iter = iter->sibling();
             }
             // iterate past the end bracket
@@ -1537,39 +2122,32 @@ symbolTable * CST::createPL(node * iter, ofstream& outFS)
 
         }
         // check if not end of list
-        if (iter && iter->content() == ",")
+        if (iter && punctuatorKind(iter->name().id()) == TK_COMMA)
             iter = iter->sibling();
 
         // create a new stNode with populated parameters
         auto * variable = new stNode(idName, idType, datatype, isArr, size, curScope);
         int foundScope;
         // check if variable is in use
-        if (ST->inUse(variable, foundScope))
+        if (inUse(variable, foundScope))
         {
-            outFS << "Error on line " << lineNum << ": variable \"" << idName << "\" is already defined ";
-            if (foundScope == 0)
-                outFS << "globally\n";
-            else
-                outFS << "locally\n";
+            diag.report(foundScope == 0 ? DG_DEFINED_GLOBALLY : DG_DEFINED_LOCALLY, lineNum, idName);
             errorDetected = true;
             delete variable;
         }
         // check if variable is a reserve word
-        else if (checkReserveWord(variable->idName(), VAR_RESERVED_WORDS))
+        else if (checkReserveWord(variable->idName(), KF_VAR_RESERVED))
         {
-            outFS << "Syntax Error on line " << lineNum << ": the name " << idName << " cannot be used as it\n";
-            outFS << " is a reserve word\n";
+            diag.report(DG_RESERVED_PARAMETER_NAME, lineNum, idName);
             errorDetected = true;
             delete variable;
         }
         // insert to the parameter list
         else
             PL->insert(variable);
-        outFS.flush();
 
         // reset the parameters (for the symbol table)
-        datatype.clear();
-        idName.clear();
+        datatype = idName = internedString();
         size = 0;
         isArr = false;
     }
@@ -1582,62 +2160,64 @@ symbolTable * CST::createPL(node * iter, ofstream& outFS)
  * This parses a function
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the function
  */
-node * CST::parseFunction(token *& iter, ofstream& outFS)
+node * CST::parseFunction(tokenIter& iter, diagnostics& diag, node *& last)
 {
     // symbol table parameters
-    string idName, idType = "function", datatype;
+    internedString idName, datatype;
+    symbolKind idType = SK_FUNCTION;
     prevScope++;
     curScope = prevScope;
 
     int origLineNum = lineNum;
     // ensure statement begins with function
-    if (!match(iter, "function"))
+    if (!match(iter, KW_FUNCTION))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED FUNCTION\n";
+        diag.report(DG_EXPECTED_FUNCTION, lineNum);
     }
 
     // catch function
-    auto * parent = new node(iter->content(), curScope);
-    node * _node = getLastNode(parent);
+    auto * parent = nodes.make<node>(iter, curScope);
+    node * _node = parent, * tail;
     iter = iter->next();
 
     // check return type
     if (!isDatatype(iter))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED DATATYPE\n";
+        diag.report(DG_EXPECTED_FUNCTION_DATATYPE, lineNum);
     }
 
     // catch return type
-    datatype = iter->content();
-    auto * child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    datatype = iter->name();
+    auto * child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // ensure function name is an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED IDENTIFIER\n";
+        diag.report(DG_EXPECTED_NAME, lineNum);
     }
 
     // set current function and symbol parameter
-    curFunction = idName = iter->content();
+    curFunction = idName = iter->name();
 
     // check if name is a reserve word
-    if (checkReserveWord(idName, FUNCTION_SPECIFIC_RESERVES))
+    if (checkReserveWord(idName.view(), KF_FUNCTION_RESERVED))
     {
-        outFS << "Syntax error on line " << lineNum << ": " << idName << " can not be used as the name of a function\n";
+        diag.report(DG_RESERVED_FUNCTION_NAME, lineNum, idName);
         errorDetected = true;
     }
 
     // catch function name
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
 
     // create a new symbol table node and insert it
     auto * function = new stNode(idName, idType, datatype, curScope);
@@ -1645,56 +2225,57 @@ node * CST::parseFunction(token *& iter, ofstream& outFS)
     iter = iter->next();
 
     // ensure there is a left parentheses after name
-    if (!match(iter, "("))
+    if (!match(iter, TK_L_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED (\n";
+        diag.report(DG_EXPECTED_PARAMETERS_OPEN, lineNum);
     }
 
     // catch the parentheses
-    child = new node("(", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>("(", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // retrieve the parameter list (if it exists)
-    auto * paramList = parseParameterList(iter, outFS);
+    auto * paramList = parseParameterList(iter, diag, tail);
     // if no expected parameters, ensure it has void instead
-    if (!paramList && !match(iter, "void") )
+    if (!paramList && !match(iter, KW_VOID) )
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED void\n";
+        diag.report(DG_EXPECTED_VOID, lineNum);
     }
 
     // populate a new symbol table with the parameter list and insert it
     symbolTable * PL = nullptr;
     if (paramList) {
         child = paramList;
-        PL = createPL(child, outFS);
-        ST->insertST(PL);
+        PL = createPL(child, diag);
+        addParamList(PL);
     }
     else
-        child = new node(iter->content(), curScope);
+        child = tail = nodes.make<node>(iter, curScope);
 
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    insert(parent, _node, child, tail, origLineNum);
 
     // ensure there is a closing parentheses
-    if (!match(iter, ")"))
+    if (!match(iter, TK_R_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": EXPECTED )\n";
+        diag.report(DG_EXPECTED_PARAMETERS_CLOSE, lineNum);
     }
 
     // catch end parentheses
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // parse until next actual token
     parseEndlToken(iter);
 
     // consume the function's statements and insert them into the structure
-    child = parseBlockStatement(iter, outFS);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = parseBlockStatement(iter, diag, tail);
+    insert(parent, _node, child, tail, origLineNum);
+    last = _node;
     return parent;
 
 }
@@ -1707,9 +2288,10 @@ node * CST::parseFunction(token *& iter, ofstream& outFS)
  * @return true if the token has the string, false if the token is null
  * or has a different string
  */
-bool CST::match(token *& iter, const string& expected)
+bool CST::match(tokenIter& iter, internedString expected)
 {
-    if (iter && iter->content() == expected)
+    stopIfCancelled(iter);
+    if (iter && iter->name() == expected)
     {
         return true;
     }
@@ -1717,84 +2299,116 @@ bool CST::match(token *& iter, const string& expected)
 }
 
 
+/***
+ * This checks if a given token is a set special token (compared by interned ID,
+ * so a string with the same text matches too)
+ * @param iter given token
+ * @param expected the expected special token
+ * @return true if the token is the special token, false if the token is null
+ * or is something else
+ */
+bool CST::match(tokenIter& iter, tokenKind expected)
+{
+    stopIfCancelled(iter);
+    return iter && punctuatorKind(iter->name().id()) == expected;
+}
+
+
+/***
+ * This checks if a given token is a set keyword (compared by interned ID)
+ * @param iter given token
+ * @param expected the expected keyword
+ * @return true if the token is the keyword, false if the token is null
+ * or is something else
+ */
+bool CST::match(tokenIter& iter, keywordKind expected)
+{
+    stopIfCancelled(iter);
+    return iter && iter->name().id() == keywordId(expected);
+}
+
+
 /***
  * This parses a factor in an expression
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the factor
  */
-node* CST::parseFactor( token *& iter, ofstream& outFS)
+node* CST::parseFactor( tokenIter& iter, diagnostics& diag, node *& last)
 {
     // initialize node pointers
     int origLineNum = lineNum;
-    node* parent = nullptr, *child = nullptr, *_node = nullptr;
-    token * peek = iter->next();
+    node* parent = nullptr, *child = nullptr, *_node = nullptr, *tail;
+    tokenIter peek = iter->next();
 
     // check if the factor is a parenthesized expression
-    if (match(iter, "(")) {
+    if (match(iter, TK_L_PAREN)) {
 
         // catch opening parentheses
-        parent = new node("(", curScope);
+        parent = nodes.make<node>("(", curScope);
         _node = parent;
         iter = iter->next();
 
         // catch expression
-        child = parseNumericalExpression(iter, outFS);
-        insert(parent, _node, child, getLastNode(child), origLineNum);
+        child = parseNumericalExpression(iter, diag, tail);
+        insert(parent, _node, child, tail, origLineNum);
 
         // ensure there is an end parentheses
-        if (!match(iter, ")"))
+        if (!match(iter, TK_R_PAREN))
         {
-            errorDetected = true; outFS << "Syntax error on line " << lineNum << ": Expected ')'\n";
+            errorDetected = true; diag.report(DG_EXPECTED_CLOSE_PARENTHESIS, lineNum);
         }
 
         // catch closing parentheses
-        child = new node(iter->content(), curScope);
+        child = nodes.make<node>(iter, curScope);
         insert(parent, _node, child, child, origLineNum);
         iter = iter->next();
     }
     // check if the token is an identifier or an integer
-    else if (matchType(iter, INTEGER) || matchType(iter, IDENTIFIER))
+    else if (matchType(iter, TK_INTEGER) || matchType(iter, TK_IDENTIFIER))
     {
         // if current token is an identifier and next is a parentheses (user function)
-        if (matchType(iter, IDENTIFIER) && peek && match(peek, "("))
+        if (matchType(iter, TK_IDENTIFIER) && peek && match(peek, TK_L_PAREN))
         {
-            return parseUserDefinedFunction(iter, outFS);
+            return parseUserDefinedFunction(iter, diag, last);
 
         }
         // not a user function
         else {
             // catch identifier
-            string variableName = iter->content(), prevType = iter->_type();
-            parent = new node(iter->content(), curScope);
+            internedString variableName = iter->name();
+            tokenKind prevType = iter->kind();
+            parent = nodes.make<node>(iter, curScope);
             _node = parent;
             iter = iter->next();
 
             // if identifier is an array
-            if (prevType == IDENTIFIER && match(iter, "[")) {
-                parseBracket(iter, outFS, parent, child, _node, variableName, origLineNum);
+            if (prevType == TK_IDENTIFIER && match(iter, TK_L_BRACKET)) {
+                parseBracket(iter, diag, parent, child, _node, variableName, origLineNum);
             }
         }
 
     }
     // single quote string
-    else if (match(iter, "'"))
+    else if (match(iter, TK_SINGLE_QUOTE))
     {
-        parent = parseSingleQuoteString(iter, outFS);
+        parent = parseSingleQuoteString(iter, diag, _node);
     }
     // double quote string
-    else if (match(iter, "\""))
+    else if (match(iter, TK_DOUBLE_QUOTE))
     {
-        parent = parseDoubleQuoteString(iter, outFS);
+        parent = parseDoubleQuoteString(iter, diag, _node);
     }
     // invalid factor
     else
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected identifier, integer, or '('\n";
+        diag.report(DG_EXPECTED_FACTOR, lineNum);
     }
 
+    last = _node;
     return parent;
 }
 
@@ -1803,83 +2417,85 @@ node* CST::parseFactor( token *& iter, ofstream& outFS)
  * This parses a user function
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the user function call
  */
-node* CST::parseUserDefinedFunction( token *& iter, ofstream& outFS)
+node* CST::parseUserDefinedFunction( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // ensure beginning term is an identifier
-    if (!matchType(iter, IDENTIFIER))
+    if (!matchType(iter, TK_IDENTIFIER))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected function name\n";
+        diag.report(DG_EXPECTED_FUNCTION_NAME, lineNum);
     }
 
     // catch function name
-    node* parent = new node(iter->content(), curScope);
+    node* parent = nodes.make<node>(iter, curScope);
     node* _node = parent;
-    node* child = nullptr;
+    node* child = nullptr, * tail;
     iter = iter->next();
 
     // ensure there is a left parentheses immediately after
-    if (!match(iter, "("))
+    if (!match(iter, TK_L_PAREN))
     {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected '(' after function name\n";
+        diag.report(DG_EXPECTED_CALL_OPEN, lineNum);
     }
 
     // catch parentheses
-    child = new node("(", curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>("(", curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
 
     // if term is an identifier
-    if (matchType(iter, IDENTIFIER))
+    if (matchType(iter, TK_IDENTIFIER))
     {
 
-        token* lookahead = iter->next();
+        tokenIter lookahead = iter->next();
         // if the current token is an array, parse past the brackets to check the type
         // of expression is after it
-        if (match(lookahead, "["))
+        if (match(lookahead, TK_L_BRACKET))
         {
             // iterate until you get to the closing bracket
-            while (lookahead && !match(lookahead, "]"))
+            while (lookahead && !match(lookahead, TK_R_BRACKET))
                 lookahead = lookahead->next();
             // ensure you do not accidentally reference a null pointer (error is caught in later functions)
             // and iterate past the end bracket
-            if (match(lookahead, "]"))
+            if (match(lookahead, TK_R_BRACKET))
                 lookahead = lookahead->next();
         }
         // check for additional parameters
-        if (match(lookahead, ","))
+        if (match(lookahead, TK_COMMA))
         {
-            node* args = parseIdentifierAndIdentifierArrayList(iter, outFS);
-            insert(parent,_node, args, getLastNode(args),origLineNum);
+            node* args = parseIdentifierAndIdentifierArrayList(iter, diag, tail);
+            insert(parent,_node, args, tail,origLineNum);
         }
         // must be an expression
         else
         {
-            node* expr = parseExpression(iter, outFS);
-            insert(parent,_node, expr, getLastNode(expr),origLineNum);
+            node* expr = parseExpression(iter, diag, tail);
+            insert(parent,_node, expr, tail,origLineNum);
         }
     }
     // parse the expression inside the function call
     else
     {
 
-        node* expr = parseExpression(iter, outFS);
-        insert(parent,_node, expr, getLastNode(expr),origLineNum);
+        node* expr = parseExpression(iter, diag, tail);
+        insert(parent,_node, expr, tail,origLineNum);
     }
 
     // ensure there is an ending parentheses
-    if (!match(iter, ")"))
-    { errorDetected = true; outFS << "Syntax error on line " << lineNum << ": Expected ')' after function arguments\n";}
+    if (!match(iter, TK_R_PAREN))
+    { errorDetected = true; diag.report(DG_EXPECTED_CALL_CLOSE, lineNum);}
 
     // catch the ending parentheses
-    child = new node(iter->content(), curScope);
-    insert(parent, _node, child, getLastNode(child), origLineNum);
+    child = nodes.make<node>(iter, curScope);
+    insert(parent, _node, child, child, origLineNum);
     iter = iter->next();
+    last = _node;
     return parent;
 }
 
@@ -1888,23 +2504,26 @@ node* CST::parseUserDefinedFunction( token *& iter, ofstream& outFS)
  * This is use d if a user function call is an entire statement itself
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the user function call
  */
-node* CST::parseUserDefinedFunctionStatement( token *& iter, ofstream& outFS)
+node* CST::parseUserDefinedFunctionStatement( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // call helper
-    auto *parent = parseUserDefinedFunction(iter, outFS), *_node = getLastNode(parent);
+    node *_node;
+    auto *parent = parseUserDefinedFunction(iter, diag, _node);
     // ensure there is an ending semicolon
-    if (!match(iter, ";")) {
+    if (!match(iter, TK_SEMICOLON)) {
         errorDetected = true;
-        outFS << "Syntax error on line " << lineNum << ": Expected semicolon after user function\n";
+        diag.report(DG_EXPECTED_CALL_SEMICOLON, lineNum);
     }
     // catch ending semicolon
-    auto *child = new node(";", curScope);
+    auto *child = nodes.make<node>(";", curScope);
     insert(parent, _node, child, child, origLineNum);
     iter = iter->next(); // parse past semicolon
+    last = _node;
     return parent;
 }
 
@@ -1913,28 +2532,29 @@ node* CST::parseUserDefinedFunctionStatement( token *& iter, ofstream& outFS)
  * This function parses an expression
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the expression
  */
-node* CST::parseExpression( token *& iter, ofstream& outFS) {
+node* CST::parseExpression( tokenIter& iter, diagnostics& diag, node *& last) {
 
-    token* peek = iter;
+    tokenIter peek = iter;
 
     // check if expression is a boolean expression
     while (peek && !peek->isEndlToken())
     {
         // check if current peek token is a boolean operator
         if (isBooleanOperator(peek)) {
-            return parseBooleanExpression(iter, outFS);
+            return parseBooleanExpression(iter, diag, last);
         }
 
-        if (peek->content() == ";" || peek->content()  == ")" || peek->content()  == ",")
+        if (match(peek, TK_SEMICOLON) || match(peek, TK_R_PAREN) || match(peek, TK_COMMA))
             break;
 
         peek = peek->next();
     }
     // numerical expression
-    return parseNumericalExpression(iter, outFS);
+    return parseNumericalExpression(iter, diag, last);
 }
 
 
@@ -1942,29 +2562,31 @@ node* CST::parseExpression( token *& iter, ofstream& outFS) {
  * This function parses a numerical expression
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the expression
  */
-node* CST::parseNumericalExpression( token *& iter, ofstream& outFS)
+node* CST::parseNumericalExpression( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // parse the initial term
-    node* parent = parseTerm(iter, outFS);
-    node* _node = getLastNode(parent);
+    node* _node, * tail;
+    node* parent = parseTerm(iter, diag, _node);
 
     // while there are addition/subtractions
-    while (match(iter, "+") || match(iter, "-"))
+    while (match(iter, TK_PLUS) || match(iter, TK_MINUS))
     {
         // catch operator
-        node* op = new node(iter->content(), curScope);
-        insert(parent,_node, op, getLastNode(op), origLineNum);
+        node* op = nodes.make<node>(iter, curScope);
+        insert(parent,_node, op, op, origLineNum);
         iter = iter->next();
 
         // parse next term
-        node* right = parseTerm(iter, outFS);
-        insert(parent,_node, right, getLastNode(right), origLineNum);
+        node* right = parseTerm(iter, diag, tail);
+        insert(parent,_node, right, tail, origLineNum);
     }
 
+    last = _node;
     return parent;
 }
 
@@ -1973,29 +2595,31 @@ node* CST::parseNumericalExpression( token *& iter, ofstream& outFS)
  * This parses a term for expressions
  *
  * @param iter current node in the token list
- * @param outFS file stream for errors
+ * @param diag gets the errors
+ * @param last set to the last node of the structure
  * @return root node of the expression
  */
-node* CST::parseTerm( token *& iter, ofstream& outFS)
+node* CST::parseTerm( tokenIter& iter, diagnostics& diag, node *& last)
 {
     int origLineNum = lineNum;
     // catch the initial factor
-    node* parent = parseFactor(iter, outFS);
-    node * _node = getLastNode(parent);
+    node * _node, * tail;
+    node* parent = parseFactor(iter, diag, _node);
 
     // while there are high precedence operators
-    while (match(iter, "*") || match(iter, "/") || match(iter, "%"))
+    while (match(iter, TK_ASTERISK) || match(iter, TK_DIVIDE) || match(iter, TK_MODULO))
     {
         // catch operator
-        node* op = new node(iter->content(), curScope);
-        insert(parent,_node, op, getLastNode(op), origLineNum);
+        node* op = nodes.make<node>(iter, curScope);
+        insert(parent,_node, op, op, origLineNum);
         iter = iter->next();
 
         // catch next factor
-        node* right = parseFactor(iter, outFS);
-        insert(parent,_node, right, getLastNode(right), origLineNum);
+        node* right = parseFactor(iter, diag, tail);
+        insert(parent,_node, right, tail, origLineNum);
     }
 
+    last = _node;
     return parent;
 }
 
@@ -2007,9 +2631,10 @@ node* CST::parseTerm( token *& iter, ofstream& outFS)
  * @param expected type of token to be compared
  * @return true if the token is that type, false if not
  */
-bool CST::matchType(token *& iter, const string& expected)
+bool CST::matchType(tokenIter& iter, tokenKind expected)
 {
-    if (iter && iter->_type() == expected)
+    stopIfCancelled(iter);
+    if (iter && iter->kind() == expected)
     {
         return true;
     }
@@ -2032,48 +2657,8 @@ void CST::outputTraversal(const string& outputFile)
         exit(3);
     }
 
-    traverseCST(head,outFS);
-//    if (head)
-//        outFS << "null";
+    tree.output(outFS);
 
     outFS.close();
 
 }
-
-#include <iomanip>
-#define ORIGINAL_LENGTH 1
-int lineWidth = ORIGINAL_LENGTH;
-
-
-/***
- * This traverse the CST and outputs the tokens in their tree
- * structure
- * @param head root node of the tree
- * @param outFS output file stream
- */
-void traverseCST(node * head, ofstream& outFS)
-{
-    if (!head)
-        return;
-//    outFS << "[" << head->content() << "]->";
-//    if (head->sibling())
-//        lineWidth += head->content().size() + 4;
-    outFS << head->content() << " ";
-//    if (head->sibling())
-//        lineWidth += head->content().size();
-
-    traverseCST(head->sibling(), outFS);
-
-    if (head->child())
-    {
-        outFS << "\n\n" << setw(lineWidth);
-        traverseCST(head->child(), outFS);
-
-
-        lineWidth = ORIGINAL_LENGTH;
-
-    }
-
-}
-
-                                                                                                                   
@@ -4,82 +4,151 @@
 
 #ifndef ASSIGNMENT3_CST_H
 #define ASSIGNMENT3_CST_H
-#include "../tokenize/token.h"
+#include "../tokenize/tokenBuffer.h"
 #include "../symbolTable/symbolTable.h"
 #include "node.h"
+#include "flatCST.h"
+#include "../arena/arena.h"
+#include "../threadPool/threadPool.h"
+#include "../diagnostics/diagnostics.h"
+#include <deque>
 #include <fstream>
+#include <memory>
+#include <vector>
 
-#define IDENTIFIER "IDENTIFIER"
-#define STRING "STRING"
-#define INTEGER "INTEGER"
-#define CHAR "CHAR"
+class AST;
+struct programPart;
 
-void traverseCST(node * head, ofstream& outFS); // used to output the CST
+
+const size_t PARTS_PER_THREAD = 4; // parts a program is split into for each thread (see parseInParallel)
+const uint32_t MIN_PART_TOKENS = 4096; // a program shorter than two parts is parsed in one thread
+
+
+// the symbol table lookups the parser makes
+enum symbolQueryKind { SQ_IN_USE, SQ_EXISTS, SQ_NOT_INDEXABLE };
+
+
+/***
+ * This is a symbol table lookup made while parsing part of a program on its own. The
+ * table only held that part, so the answer is checked against the parts before it
+ * before the part is used (see CST::mergeParts)
+ */
+struct symbolQuery {
+    symbolQueryKind kind;
+    internedString name;
+    bool isArr; // the variable looked up is an array (SQ_IN_USE)
+    bool answer;
+    int foundScope; // scope of the variable found (SQ_IN_USE)
+};
 
 class CST
 {
 public:
 
-    // constructor/destructor
-    CST(token * head, const string& outputFile, symbolTable * ST);
-    ~CST() { deleteNodes(head); }
+    // constructor (the nodes are made in the CST's arena while parsing, the finished
+    // tree is kept as a flatCST and the arena is freed). Given an AST, each top level
+    // declaration is added to it as soon as it is parsed and no tree is kept (there is
+    // nothing for outputTraversal to output). Given a thread pool, the functions and
+    // procedures are parsed on it (see parseInParallel). The errors are collected while
+    // parsing and written to the output file at the end, given a limit the parse stops
+    // once that many errors were found
+    CST(tokenIter head, const string& outputFile, symbolTable * ST, AST * ast = nullptr,
+        threadPool * pool = nullptr, size_t maxErrors = 0);
+    // constructor for one piece of a program parsed on its own (see session)
+    CST(tokenIter head, diagnostics& diag, symbolTable * ST, int lineNum, int prevScope);
 
     // insertion/traversal functions
     void insert(node *& parent, node *& curNode, node *& _node, node * lastNode, int origLineNum);
+    void addDeclaration(node *& _node, node * lastNode, int origLineNum);
+    void buildAST(uint32_t end);
     static void insertSibling(node *& parent, node *& curNode, node *& _node, node * lastNode);
     static void insertChild(node *& parent, node *& curNode, node *& _node, node * lastNode);
     void outputTraversal(const string& outputFile);
-    void parseEndlToken(token *& iter);
-    static node * getLastNode(node * _node);
-    static void deleteNodes(node * _node);
-    static void parseUntilEndl(token *& iter);
-
-    // parsing functions
-    node * parse(token *& iter, ofstream&);
-    node * parseSingleQuoteString(token *& iter, ofstream&);
-    node * parseDoubleQuoteString(token *& iter, ofstream&);
-    node * parseFunction(token *& iter, ofstream&);
-    node * parseNumericalExpression(token *& iter, ofstream&);
-    node * parseBooleanExpression(token *& iter, ofstream&);
-    node * parseExpression(token *& iter, ofstream&);
-    node * parseSelectionStatement(token *& iter, ofstream&);
-    node * parseIterationStatement(token *& iter, ofstream&);
-    node * parseAssignmentStatement(token *& iter, ofstream&);
-    node * parsePrintfStatement(token *& iter, ofstream&);
-    node * parseGetCharFunction(token *& iter, ofstream&);
-    node * parseUserDefinedFunction(token *& iter, ofstream&);
-    node * parseUserDefinedFunctionStatement( token *& iter, ofstream& outFS);
-    node * parseBracket( token *& iter, ofstream &outFS, node *& parent, node *& child, node *& _node,
-                         const string& variableName, const int& origLineNum);
-    node * parseDeclarationStatement(token *& iter, ofstream&);
-    node * parseReturnStatement(token *& iter, ofstream&);
-    node * parseStatement(token *& iter, ofstream&);
-    node * parseCompoundStatement(token *& iter, ofstream&);
-    node * parseBlockStatement(token *& iter, ofstream&);
-    node * parseParameterList(token *& iter, ofstream&);
-    node * parseProcedureDeclaration(token *& iter, ofstream&);
-    node * parseIdentifierAndIdentifierArrayList(token *& iter, ofstream&);
-    node * parseIncrementStatement(token *& iter, ofstream&);
-    node * parseFactor(token *& iter, ofstream&);
-    node * parseTerm(token *& iter, ofstream&);
-    node * root() { return head; }
-    symbolTable * createPL(node * iter, ofstream& outFS);
-
-    bool match(token *& iter, const string& expected);
-    bool matchType(token *& iter, const string& expected);
-    bool isDatatype(token *& iter);
-    static bool isBooleanOperator(token *& iter);
+    void parseEndlToken(tokenIter& iter);
+    node * makeLiteral(const tokenIter& token);
+    static void parseUntilEndl(tokenIter& iter);
+
+    // parallel parsing functions
+    void parseDeclarations(tokenIter& iter, diagnostics& diag, node *& parent, node *& _node, uint32_t end);
+    void parseInParallel(tokenIter& iter, diagnostics& diag, node *& parent, node *& _node);
+    void mergeParts(deque<programPart>& parts, tokenIter& iter, diagnostics& diag, node *& parent, node *& _node);
+    void addPart(node *& parent, node *& _node, node * root, node * last, bool isChild);
+
+    // symbol table functions (they log the lookups when parsing part of a program)
+    void logQuery(const symbolQuery& query);
+    bool inUse(stNode * variable, int& foundScope);
+    bool exists(internedString variableName);
+    bool notIndexable(internedString variableName);
+    void addParamList(symbolTable * PL);
+
+    // piece functions (see session)
+    [[nodiscard]] node * pieceHead() const { return pieceRoot; }
+    [[nodiscard]] node * pieceTail() const { return pieceLast; }
+    [[nodiscard]] bool startsLine() const { return firstStartsLine; }
+    [[nodiscard]] int lastScope() const { return prevScope; }
+    void shiftScopes(int delta);
+
+    // parsing functions (given last, one sets it to the last node of the structure it
+    // returns so the caller links after it without walking it)
+    node * parse(tokenIter& iter, diagnostics&);
+    node * parseSingleQuoteString(tokenIter& iter, diagnostics&, node *& last);
+    node * parseDoubleQuoteString(tokenIter& iter, diagnostics&, node *& last);
+    node * parseFunction(tokenIter& iter, diagnostics&, node *& last);
+    node * parseNumericalExpression(tokenIter& iter, diagnostics&, node *& last);
+    node * parseBooleanExpression(tokenIter& iter, diagnostics&, node *& last);
+    node * parseExpression(tokenIter& iter, diagnostics&, node *& last);
+    node * parseSelectionStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseIterationStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseAssignmentStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parsePrintfStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseGetCharFunction(tokenIter& iter, diagnostics&, node *& last);
+    node * parseUserDefinedFunction(tokenIter& iter, diagnostics&, node *& last);
+    node * parseUserDefinedFunctionStatement( tokenIter& iter, diagnostics& diag, node *& last);
+    node * parseBracket( tokenIter& iter, diagnostics& diag, node *& parent, node *& child, node *& _node,
+                         internedString variableName, const int& origLineNum);
+    node * parseDeclarationStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseReturnStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseCompoundStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseBlockStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseParameterList(tokenIter& iter, diagnostics&, node *& last);
+    node * parseProcedureDeclaration(tokenIter& iter, diagnostics&, node *& last);
+    node * parseIdentifierAndIdentifierArrayList(tokenIter& iter, diagnostics&, node *& last);
+    node * parseIncrementStatement(tokenIter& iter, diagnostics&, node *& last);
+    node * parseFactor(tokenIter& iter, diagnostics&, node *& last);
+    node * parseTerm(tokenIter& iter, diagnostics&, node *& last);
+    cstIter root() const { return tree.root(); }
+    const flatCST& flat() const { return tree; }
+    symbolTable * createPL(node * iter, diagnostics& diag);
+
+    bool match(tokenIter& iter, internedString expected);
+    static bool match(tokenIter& iter, tokenKind expected);
+    static bool match(tokenIter& iter, keywordKind expected);
+    static bool matchType(tokenIter& iter, tokenKind expected);
+    bool isDatatype(tokenIter& iter);
+    static bool isBooleanOperator(tokenIter& iter);
     [[nodiscard]] bool hasErrors() const { return errorDetected; }
 
 
 private:
-    node * head;
-    string curFunction;
+    CST(symbolTable * ST, int lineNum, int prevScope, programPart * part);
+
+    arena nodes; // holds every node of the CST while it is being parsed
+    flatCST tree; // the finished CST
+    internedString curFunction;
     int lineNum = 1;
     int curScope = 0;
     int prevScope = 0;
     bool errorDetected = false;
     symbolTable * ST;
+    AST * ast; // AST being built while parsing (null once it stops being built)
+    bool direct; // true if each declaration is added to the AST once it is parsed
+    threadPool * pool = nullptr; // threads the functions are parsed on (null to parse them in order)
+    vector<unique_ptr<CST>> partParsers; // parsers of the parts in the tree (they hold its nodes)
+    programPart * part = nullptr; // the part of a program being parsed (null for a whole program)
+    node * pieceRoot = nullptr, * pieceLast = nullptr; // the piece parsed by the piece constructor
+    bool firstStartsLine = false; // true if the first declaration parsed began a new line
+    bool linkParamLists = false; // true if the parameter lists are added to their function nodes later
 
 };
 
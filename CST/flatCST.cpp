@@ -0,0 +1,140 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "flatCST.h"
+#include <iomanip>
+using namespace std;
+
+
+/***
+ * This copies a linked CST into the arrays, the nodes are numbered in the order they
+ * are output
+ * @param root root node of the CST
+ */
+flatCST::flatCST(node * root)
+{
+    append(root, nullptr, false);
+}
+
+
+/***
+ * This copies a linked structure to the end of the arrays and links it after the last
+ * structure appended, the same way CST::insert links it
+ * @param root root node of the structure
+ * @param last last node of the structure (the next structure is linked to it)
+ * @param isChild true if the structure starts a new line (it is linked as a child)
+ * @return the index of the root node (NO_NODE if the structure is empty)
+ */
+uint32_t flatCST::append(node * root, node * last, bool isChild)
+{
+    if (!root)
+        return NO_NODE;
+
+    // chains whose first node still has to be numbered (the last one is next)
+    vector<pair<uint32_t, node *>> pending;
+    uint32_t parent = NO_NODE, prev = NO_NODE;
+    int line = 1;
+    if (tail != NO_NODE)
+    {
+        line = lines[tail - _base] + (isChild ? 1 : 0);
+        (isChild ? parent : prev) = tail;
+    }
+    uint32_t first = size();
+    tail = NO_NODE;
+
+    while (true)
+    {
+        // number the chain of siblings
+        for (node * cur = root; cur; cur = cur->sibling())
+        {
+            uint32_t idx = add(cur, line);
+            if (cur == last)
+                tail = idx;
+            if (prev != NO_NODE)
+                siblings[prev - _base] = idx;
+            else if (parent != NO_NODE)
+                children[parent - _base] = idx;
+            if (cur->child())
+                pending.emplace_back(idx, cur->child());
+            prev = idx;
+        }
+
+        if (pending.empty())
+            break;
+        parent = pending.back().first;
+        root = pending.back().second;
+        line = lines[parent - _base] + 1;
+        prev = NO_NODE;
+        pending.pop_back();
+    }
+    return first;
+}
+
+
+/***
+ * This drops every node before the given one (and the literals they hold), the indices
+ * of the rest do not change
+ * @param idx index of the first node to keep
+ */
+void flatCST::release(uint32_t idx)
+{
+    uint32_t count = idx - _base;
+    for (uint32_t cur = 0; cur < count; cur++)
+    {
+        if (texts[cur] & LITERAL_TEXT)
+        {
+            literals.pop_front();
+            _literalBase++;
+        }
+    }
+    kinds.erase(kinds.begin(), kinds.begin() + count);
+    texts.erase(texts.begin(), texts.begin() + count);
+    scopes.erase(scopes.begin(), scopes.begin() + count);
+    lines.erase(lines.begin(), lines.begin() + count);
+    children.erase(children.begin(), children.begin() + count);
+    siblings.erase(siblings.begin(), siblings.begin() + count);
+    _base = idx;
+}
+
+
+/***
+ * This adds a node without any links, the text of a string literal is copied (the
+ * node's copy goes when the CST's arena is freed)
+ * @param _node the node
+ * @param line the line of the node
+ * @return the index of the node
+ */
+uint32_t flatCST::add(node * _node, int line)
+{
+    kinds.push_back(_node->kind());
+    if (_node->kind() == TK_STRING)
+    {
+        texts.push_back(LITERAL_TEXT | (_literalBase + (uint32_t) literals.size()));
+        literals.emplace_back(_node->content());
+    }
+    else
+        texts.push_back(_node->name().id());
+    scopes.push_back(_node->scope());
+    lines.push_back(line);
+    children.push_back(NO_NODE);
+    siblings.push_back(NO_NODE);
+    return size() - 1;
+}
+
+
+/***
+ * This outputs the tokens in their tree structure, every chain of siblings is on its
+ * own line. The nodes are already in output order, a node starts a new chain when it
+ * is not the sibling of the node before it
+ * @param outFS output file stream
+ */
+void flatCST::output(ofstream& outFS) const
+{
+    for (uint32_t idx = _base; idx < size(); idx++)
+    {
+        if (idx > _base && sibling(idx - 1) != idx)
+            outFS << "\n\n" << setw(1);
+        outFS << name(idx) << " ";
+    }
+}
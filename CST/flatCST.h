@@ -0,0 +1,114 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_FLATCST_H
+#define ASSIGNMENT5_FLATCST_H
+#include "node.h"
+#include "../tokenize/tokenKind.h"
+#include "../interner/interner.h"
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+class flatCST;
+
+
+const uint32_t NO_NODE = UINT32_MAX; // index used for a missing child/sibling
+const uint32_t LITERAL_TEXT = 1u << 31; // marks a node text that is a literal's index, not an ID
+
+
+/***
+ * This is a position in a flat CST, it is used by the AST builder the same way a node
+ * pointer was (iter->sibling(), iter->content(), !iter, etc)
+ */
+class cstIter {
+
+public:
+    cstIter(): tree{nullptr}, idx{NO_NODE} {}
+    cstIter(const flatCST * tree, uint32_t idx): tree{tree}, idx{idx} {}
+
+    explicit operator bool() const { return idx != NO_NODE; }
+    const cstIter * operator->() const { return this; }
+
+    [[nodiscard]] cstIter child() const;
+    [[nodiscard]] cstIter sibling() const;
+    [[nodiscard]] string_view content() const { return name().view(); }
+    [[nodiscard]] internedString name() const;
+    [[nodiscard]] tokenKind kind() const;
+    [[nodiscard]] int scope() const;
+    [[nodiscard]] int line() const;
+    [[nodiscard]] uint32_t index() const { return idx; }
+
+private:
+    const flatCST * tree;
+    uint32_t idx;
+};
+
+
+/***
+ * This holds a finished CST as parallel arrays indexed by node number instead of linked
+ * node objects (about 21 bytes a node instead of a node object in the arena). Nodes are
+ * numbered in the order the tree is output (a node, its siblings, then its child), so a
+ * walk of a program's chain of nodes reads each array front to back. It can also hold a
+ * window of a CST that is still being parsed, the declarations are appended as they are
+ * parsed and released once the AST has been built from them (like a token stream)
+ */
+class flatCST {
+
+public:
+    flatCST() = default;
+    explicit flatCST(node * root);
+
+    uint32_t append(node * root, node * last, bool isChild);
+    void release(uint32_t idx);
+    void output(ofstream& outFS) const;
+
+    [[nodiscard]] cstIter root() const { return {this, empty() ? NO_NODE : _base}; }
+    [[nodiscard]] uint32_t size() const { return _base + (uint32_t) kinds.size(); }
+    [[nodiscard]] bool empty() const { return kinds.empty(); }
+
+    [[nodiscard]] tokenKind kind(uint32_t idx) const { return kinds[idx - _base]; }
+    [[nodiscard]] internedString name(uint32_t idx) const;
+    [[nodiscard]] int scope(uint32_t idx) const { return scopes[idx - _base]; }
+    [[nodiscard]] int line(uint32_t idx) const { return lines[idx - _base]; }
+    [[nodiscard]] uint32_t child(uint32_t idx) const { return children[idx - _base]; }
+    [[nodiscard]] uint32_t sibling(uint32_t idx) const { return siblings[idx - _base]; }
+
+private:
+    uint32_t add(node * _node, int line);
+
+    vector<tokenKind> kinds;
+    vector<uint32_t> texts; // interned ID of each node's text (or LITERAL_TEXT | its index)
+    deque<string> literals; // text of the string literals (they are not interned)
+    vector<int32_t> scopes;
+    vector<int32_t> lines; // counts the child links from the root, starting at 1
+    vector<uint32_t> children; // first child (NO_NODE if there is none)
+    vector<uint32_t> siblings; // next sibling (NO_NODE if there is none)
+    uint32_t _base = 0; // index of the first node kept (a window drops earlier ones)
+    uint32_t _literalBase = 0; // index of the first literal kept
+    uint32_t tail = NO_NODE; // last node of the last structure appended
+
+};
+
+
+inline internedString flatCST::name(uint32_t idx) const
+{
+    uint32_t text = texts[idx - _base];
+    if (text & LITERAL_TEXT)
+        return internedString::literal(literals[(text & ~LITERAL_TEXT) - _literalBase]);
+    return internedString::fromId(text);
+}
+
+inline cstIter cstIter::child() const { return {tree, tree->child(idx)}; }
+inline cstIter cstIter::sibling() const { return {tree, tree->sibling(idx)}; }
+inline internedString cstIter::name() const { return tree->name(idx); }
+inline tokenKind cstIter::kind() const { return tree->kind(idx); }
+inline int cstIter::scope() const { return tree->scope(idx); }
+inline int cstIter::line() const { return tree->line(idx); }
+
+
+#endif //ASSIGNMENT5_FLATCST_H
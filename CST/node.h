@@ -5,25 +5,49 @@
 #ifndef ASSIGNMENT3_NODE_H
 #define ASSIGNMENT3_NODE_H
 #include <string>
+#include <string_view>
+#include "../interner/interner.h"
+#include "../tokenize/tokenBuffer.h"
 using namespace std;
 
 
 class node {
 
 public:
-    node(string info, int scope): _content{info}, _scope{scope}, _child{nullptr}, _sibling{nullptr}  {}
+    // fixed text (a keyword or a special token the parser puts in itself)
+    node(internedString info, int scope): _child{nullptr}, _sibling{nullptr}, _content{info}, _scope{scope},
+    _kind{literalKind(info)}  {}
+    // the current token (integers keep their decoded value)
+    node(const tokenIter& token, int scope): _child{nullptr}, _sibling{nullptr}, _content{token.name()},
+    _scope{scope}, _value{token.value()}, _kind{token.kind()}  {}
+    // a string literal token with its text (the token's text is not interned)
+    node(const tokenIter& token, internedString text, int scope): _child{nullptr}, _sibling{nullptr},
+    _content{text}, _scope{scope}, _kind{token.kind()}  {}
 
     void child(node * _node) { _child = _node; }
     node * child() { return _child; }
     void sibling(node * node) { _sibling = node; }
     node * sibling() { return _sibling; }
-    string content() { return _content; }
+    string_view content() { return _content.view(); }
+    internedString name() { return _content; }
     int scope() { return _scope; }
+    void scope(int scope) { _scope = scope; }
+    int value() { return _value; }
+    tokenKind kind() { return _kind; }
 
 private:
     node * _child, * _sibling;
-    string _content;
+    internedString _content;
     int _scope;
+    int _value = 0; // decoded value if the node holds an integer
+    tokenKind _kind;
+
+    // fixed text is a special token or a keyword
+    static tokenKind literalKind(internedString info)
+    {
+        tokenKind kind = punctuatorKind(info.id());
+        return kind == TK_UNKNOWN ? TK_IDENTIFIER : kind;
+    }
 
 };
 
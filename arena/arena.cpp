@@ -0,0 +1,107 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "arena.h"
+#include <mutex>
+using namespace std;
+
+
+// free normal blocks shared by every arena, they are freed when the program ends
+struct freeBlocks {
+    mutex lock;
+    vector<char *> blocks;
+
+    ~freeBlocks()
+    {
+        for (char * block : blocks)
+            delete[] block;
+    }
+};
+static freeBlocks blockPool;
+
+
+/***
+ * This gets a normal block, from the pool if one is free
+ * @return the block
+ */
+static char * takeBlock()
+{
+    {
+        lock_guard<mutex> guard(blockPool.lock);
+        if (!blockPool.blocks.empty())
+        {
+            char * block = blockPool.blocks.back();
+            blockPool.blocks.pop_back();
+            return block;
+        }
+    }
+    return new char[ARENA_BLOCK_BYTES];
+}
+
+
+/***
+ * This gives normal blocks back to the pool (blocks past the pool's limit are freed)
+ * @param blocks the blocks
+ */
+static void returnBlocks(vector<char *>& blocks)
+{
+    lock_guard<mutex> guard(blockPool.lock);
+    for (char * block : blocks)
+    {
+        if (blockPool.blocks.size() < ARENA_POOL_BLOCKS)
+            blockPool.blocks.push_back(block);
+        else
+            delete[] block;
+    }
+    blocks.clear();
+}
+
+
+/***
+ * Destructor (frees every object at once)
+ */
+arena::~arena()
+{
+    reset();
+}
+
+
+/***
+ * This frees every object made in the arena so it can be used again, the blocks go
+ * back to the shared pool
+ */
+void arena::reset()
+{
+    returnBlocks(blocks);
+    for (char * block : largeBlocks)
+        delete[] block;
+    largeBlocks.clear();
+    cur = end = nullptr;
+    used = 0;
+}
+
+
+/***
+ * This starts a new block when the current one is full
+ * @param size number of bytes
+ * @param align alignment of the memory (a power of two)
+ * @return the memory
+ */
+void * arena::grow(size_t size, size_t align)
+{
+    // anything bigger than a quarter block gets a block of its own so the rest of the
+    // current block is not wasted
+    if (size + align > ARENA_BLOCK_BYTES / 4)
+    {
+        auto * block = new char[size + align];
+        largeBlocks.push_back(block);
+        used += size;
+        return (char *) (((uintptr_t) block + align - 1) & ~(uintptr_t) (align - 1));
+    }
+
+    blocks.push_back(takeBlock());
+    cur = blocks.back();
+    end = cur + ARENA_BLOCK_BYTES;
+    return allocate(size, align);
+}
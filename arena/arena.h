@@ -0,0 +1,77 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_ARENA_H
+#define ASSIGNMENT5_ARENA_H
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+
+const size_t ARENA_BLOCK_BYTES = 1 << 16; // size of a normal block
+const size_t ARENA_POOL_BLOCKS = 256; // free blocks kept for the next arena (16MB)
+
+
+/***
+ * This is a bump pointer allocator, objects are carved out of large blocks one after
+ * another and are all freed at once when the arena is reset or destroyed (their
+ * destructors are never run, so only trivially destructible objects can be made in it).
+ * Freed blocks go back to a pool shared by every arena, so the next compilation in a
+ * batch reuses them instead of asking the heap again
+ */
+class arena {
+
+public:
+    arena() = default;
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+    ~arena();
+
+    void * allocate(size_t size, size_t align);
+    void reset();
+    [[nodiscard]] size_t bytesUsed() const { return used; }
+
+    template <typename T, typename... Args>
+    T * make(Args&&... args)
+    {
+        static_assert(is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+private:
+    void * grow(size_t size, size_t align);
+
+    vector<char *> blocks; // normal blocks, the last one is being filled
+    vector<char *> largeBlocks; // blocks made for a single large allocation
+    char * cur = nullptr;
+    char * end = nullptr;
+    size_t used = 0;
+
+};
+
+
+/***
+ * This gives out memory from the current block (the common case is inlined)
+ * @param size number of bytes
+ * @param align alignment of the memory (a power of two)
+ * @return the memory
+ */
+inline void * arena::allocate(size_t size, size_t align)
+{
+    auto start = (char *) (((uintptr_t) cur + align - 1) & ~(uintptr_t) (align - 1));
+    if (cur && start + size <= end)
+    {
+        cur = start + size;
+        used += size;
+        return start;
+    }
+    return grow(size, align);
+}
+
+
+#endif //ASSIGNMENT5_ARENA_H
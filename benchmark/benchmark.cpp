@@ -0,0 +1,407 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "benchmark.h"
+#include "../tokenize/lexer.h"
+#include "../tokenize/tokenize.h"
+#include "../CST/CST.h"
+#include "../AST/AST.h"
+#include "../session/session.h"
+#include "../resolver/resolver.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+using namespace std;
+
+
+const int CONSTRUCTION_SIZES[] = {10000, 20000, 50000, 100000};
+const int PARALLEL_FUNCTION_COUNTS[] = {100, 200, 500, 1000};
+const int PARALLEL_FUNCTION_STATEMENTS = 50; // statements in each function
+const unsigned int PARALLEL_PARSE_THREADS = 4; // the shared pool has one thread on a one core host
+const int INCREMENTAL_FUNCTION_COUNTS[] = {100, 200, 400};
+const int SYMBOL_TABLE_IDENTIFIERS[] = {25000, 50000, 100000};
+const int MEMORY_FUNCTIONS = 20;
+const int MEMORY_COMPILES = 5000;
+const int MEMORY_CHECKPOINT = 500; // compiles between readings of the memory in use
+const long MEMORY_SLACK_KB = 512; // growth after the first reading that is still flat
+
+
+/***
+ * This builds a program whose main procedure has the given number of statements, the
+ * statements cycle through assignments, if/else blocks, while loops and printf calls
+ * @param statements number of statements in main
+ * @return the program
+ */
+static string generateLongMain(int statements)
+{
+    string program = "procedure main (void)\n{\n  int x, y;\n";
+    for (int idx = 0; idx < statements; idx++)
+    {
+        switch (idx % 4)
+        {
+            case 0:
+                program += "  x = x + " + to_string(idx % 97) + ";\n";
+                break;
+            case 1:
+                program += "  if (x > 10)\n  {\n    x = x - 10;\n  }\n  else\n  {\n    y = x;\n  }\n";
+                break;
+            case 2:
+                program += "  while (y < 3)\n  {\n    y = y + 1;\n  }\n";
+                break;
+            default:
+                program += "  printf (\"x = %d\\n\", x);\n";
+        }
+    }
+    program += "}\n";
+    return program;
+}
+
+
+/***
+ * This builds a program with the given number of functions, each with its own
+ * parameter and variables, followed by a main procedure that calls some of them
+ * @param functions number of functions
+ * @param statements number of statements in each function
+ * @param seed a seed other than 0 gives every name in the program its own prefix, so
+ * the programs of two seeds have no names in common
+ * @return the program
+ */
+static string generateManyFunctions(int functions, int statements, int seed = 0)
+{
+    string prefix = seed ? "s" + to_string(seed) + "_" : "";
+    string a = prefix + "a", x = prefix + "x", y = prefix + "y", r = prefix + "r";
+    string program;
+    for (int function = 0; function < functions; function++)
+    {
+        string name = prefix + "f" + to_string(function);
+        program += "function int " + name + " (int " + a + ")\n{\n  int " + x + ", " + y + ";\n";
+        for (int idx = 0; idx < statements; idx++)
+        {
+            if (idx % 2 == 0)
+                program += "  " + x + " = " + a + " + " + to_string(idx) + " * 2;\n";
+            else
+                program += "  if (" + x + " > 3)\n  {\n    " + y + " = " + x + " - 1;\n  }\n";
+        }
+        program += "  return " + x + ";\n}\n\n";
+    }
+    program += "procedure main (void)\n{\n  int " + r + ";\n";
+    for (int function = 0; function < min(functions, 50); function++)
+        program += "  " + r + " = " + prefix + "f" + to_string(function) + " (" + r + ");\n";
+    program += "}\n";
+    return program;
+}
+
+
+/***
+ * This builds a program that declares the given number of global variables and then
+ * uses each of them once in its main procedure
+ * @param identifiers number of global variables
+ * @return the program
+ */
+static string generateManyGlobals(int identifiers)
+{
+    string program;
+    for (int idx = 0; idx < identifiers; idx++)
+        program += "int v" + to_string(idx) + ";\n";
+    program += "procedure main (void)\n{\n  int r;\n";
+    for (int idx = 0; idx < identifiers; idx++)
+        program += "  r = v" + to_string(idx) + " + 1;\n";
+    program += "}\n";
+    return program;
+}
+
+
+/***
+ * This opens the file a benchmark writes its results to
+ * @param outFS the stream to open
+ * @param outputFile the file
+ * @return false if it could not be opened
+ */
+static bool openResults(ofstream& outFS, const string& outputFile)
+{
+    outFS.open(outputFile);
+    if (!outFS.is_open())
+    {
+        cout << "ERROR OPENING " << outputFile << endl;
+        return false;
+    }
+    cout << "RESULTS CAN BE FOUND AT " << outputFile << endl;
+    return true;
+}
+
+
+/***
+ * This times building the CST and AST of programs with 10k to 100k statements, the
+ * time per statement should stay about the same as the programs grow if construction
+ * is linear. It also times adding each declaration to the AST as soon as it is parsed
+ * (the direct mode), which only holds one declaration's CST at once but still builds it
+ * @param outputFile the file that gets the results
+ * @param errorFile the file that gets the CST errors (there should not be any)
+ */
+void runConstructionBenchmark(const string& outputFile, const string& errorFile)
+{
+    ofstream outFS;
+    if (!openResults(outFS, outputFile))
+        return;
+    outFS << "\nCONSTRUCTION BENCHMARK\n";
+    outFS << setw(12) << "statements" << setw(12) << "CST ms" << setw(12) << "AST ms" << setw(16) << "ns/statement"
+          << setw(12) << "direct ms\n";
+
+    for (int statements : CONSTRUCTION_SIZES)
+    {
+        // the names of the last run are dropped
+        interner::global().reset();
+        string source = generateLongMain(statements);
+        tokenBuffer TB(source);
+        lexer lex(source, &TB);
+        lex.run();
+
+        auto * ST = new symbolTable();
+        auto start = chrono::steady_clock::now();
+        auto * cst = new CST(TB.begin(), errorFile, ST);
+        auto built = chrono::steady_clock::now();
+        auto * ast = new AST(cst, ST);
+        auto finished = chrono::steady_clock::now();
+        bool failed = cst->hasErrors();
+        // the direct mode is timed without the trees of the two-pass build in memory
+        delete ast;
+        delete cst;
+        delete ST;
+
+        auto * directST = new symbolTable();
+        auto * directAST = new AST(directST);
+        auto directStart = chrono::steady_clock::now();
+        CST direct(TB.begin(), errorFile, directST, directAST);
+        auto directFinished = chrono::steady_clock::now();
+
+        double cstMs = chrono::duration<double, milli>(built - start).count();
+        double astMs = chrono::duration<double, milli>(finished - built).count();
+        double directMs = chrono::duration<double, milli>(directFinished - directStart).count();
+        outFS << setw(12) << statements << setw(12) << fixed << setprecision(1) << cstMs << setw(12) << astMs
+              << setw(15) << (cstMs + astMs) * 1e6 / statements << setw(12) << directMs << endl;
+        if (failed)
+            outFS << "    (the generated program had errors, see " << errorFile << ")\n";
+
+        delete directAST;
+        delete directST;
+    }
+}
+
+
+/***
+ * This times parsing programs with 100 to 1000 functions one function after another
+ * and on a pool of PARALLEL_PARSE_THREADS threads (the CST and symbol table are the same
+ * either way). The pool is not the shared one, a pool of one thread parses in order
+ * @param outputFile the file that gets the results
+ * @param errorFile the file that gets the CST errors (there should not be any)
+ */
+void runParallelParseBenchmark(const string& outputFile, const string& errorFile)
+{
+    ofstream outFS;
+    if (!openResults(outFS, outputFile))
+        return;
+    threadPool pool(PARALLEL_PARSE_THREADS);
+    outFS << "\nPARALLEL PARSE BENCHMARK (" << pool.size() << " threads on " << thread::hardware_concurrency()
+          << " cores)\n";
+    outFS << setw(12) << "functions" << setw(12) << "serial ms" << setw(14) << "parallel ms" << setw(10) << "speedup\n";
+
+    for (int functions : PARALLEL_FUNCTION_COUNTS)
+    {
+        // the names of the last run are dropped
+        interner::global().reset();
+        string source = generateManyFunctions(functions, PARALLEL_FUNCTION_STATEMENTS);
+        tokenBuffer TB(source);
+        lexer lex(source, &TB);
+        lex.run();
+
+        symbolTable serialST, parallelST;
+        auto start = chrono::steady_clock::now();
+        CST serial(TB.begin(), errorFile, &serialST);
+        auto serialFinished = chrono::steady_clock::now();
+        CST parallel(TB.begin(), errorFile, &parallelST, nullptr, &pool);
+        auto parallelFinished = chrono::steady_clock::now();
+
+        double serialMs = chrono::duration<double, milli>(serialFinished - start).count();
+        double parallelMs = chrono::duration<double, milli>(parallelFinished - serialFinished).count();
+        outFS << setw(12) << functions << setw(12) << fixed << setprecision(1) << serialMs << setw(14) << parallelMs
+              << setw(9) << serialMs / parallelMs << "x" << endl;
+        if (serial.hasErrors() || parallel.hasErrors())
+            outFS << "    (the generated program had errors, see " << errorFile << ")\n";
+    }
+}
+
+
+
+/***
+ * This times a session bringing programs with 100 to 400 functions up to date after
+ * one function is edited and after a function is added at the start (which shifts the
+ * scopes of every function after it), against running the whole front end again
+ * @param outputFile the file that gets the results
+ * @param errorFile the file that gets the errors (there should not be any)
+ */
+void runIncrementalBenchmark(const string& outputFile, const string& errorFile)
+{
+    ofstream outFS;
+    if (!openResults(outFS, outputFile))
+        return;
+    outFS << "\nINCREMENTAL BENCHMARK\n";
+    outFS << setw(12) << "functions" << setw(12) << "full ms" << setw(12) << "edit ms" << setw(10) << "parsed"
+          << setw(12) << "insert ms" << setw(10) << "parsed\n";
+
+    for (int functions : INCREMENTAL_FUNCTION_COUNTS)
+    {
+        // the names of the last run are dropped
+        interner::global().reset();
+        string source = generateManyFunctions(functions, PARALLEL_FUNCTION_STATEMENTS);
+        session current;
+        current.update(source, errorFile);
+
+        // change one statement of the function in the middle of the program
+        string edited = source;
+        size_t middle = edited.find("function int f" + to_string(functions / 2) + " ");
+        size_t statement = edited.find("+ 0 *", middle);
+        edited.replace(statement, 5, "+ 1 *");
+        string inserted = "function int g (int a)\n{\n  return a;\n}\n\n" + edited;
+
+        auto start = chrono::steady_clock::now();
+        session full;
+        full.update(edited, errorFile);
+        auto fullFinished = chrono::steady_clock::now();
+        current.update(edited, errorFile);
+        auto editFinished = chrono::steady_clock::now();
+        size_t editParsed = current.parsedCount();
+        current.update(inserted, errorFile);
+        auto insertFinished = chrono::steady_clock::now();
+
+        double fullMs = chrono::duration<double, milli>(fullFinished - start).count();
+        double editMs = chrono::duration<double, milli>(editFinished - fullFinished).count();
+        double insertMs = chrono::duration<double, milli>(insertFinished - editFinished).count();
+        outFS << setw(12) << functions << setw(12) << fixed << setprecision(1) << fullMs << setw(12) << editMs
+              << setw(10) << editParsed << setw(12) << insertMs << setw(10) << current.parsedCount() << endl;
+        if (full.hasErrors() || current.hasErrors())
+            outFS << "    (the generated program had errors, see " << errorFile << ")\n";
+    }
+}
+
+
+
+/***
+ * This times parsing programs with 25k to 100k global variables, every declaration
+ * checks the symbol table for a variable with the same name and every use looks its
+ * variable up, so the time per identifier should stay about the same as the programs
+ * grow if the lookups do not depend on the size of the table
+ * @param outputFile the file that gets the results
+ * @param errorFile the file that gets the CST errors (there should not be any)
+ */
+void runSymbolTableBenchmark(const string& outputFile, const string& errorFile)
+{
+    ofstream outFS;
+    if (!openResults(outFS, outputFile))
+        return;
+    outFS << "\nSYMBOL TABLE BENCHMARK\n";
+    outFS << setw(12) << "identifiers" << setw(12) << "CST ms" << setw(16) << "ns/identifier\n";
+
+    for (int identifiers : SYMBOL_TABLE_IDENTIFIERS)
+    {
+        // the names of the last run are dropped
+        interner::global().reset();
+        string source = generateManyGlobals(identifiers);
+        tokenBuffer TB(source);
+        lexer lex(source, &TB);
+        lex.run();
+
+        symbolTable ST;
+        auto start = chrono::steady_clock::now();
+        CST cst(TB.begin(), errorFile, &ST);
+        auto finished = chrono::steady_clock::now();
+
+        double cstMs = chrono::duration<double, milli>(finished - start).count();
+        outFS << setw(12) << identifiers << setw(12) << fixed << setprecision(1) << cstMs
+              << setw(15) << cstMs * 1e6 / identifiers << endl;
+        if (cst.hasErrors())
+            outFS << "    (the generated program had errors, see " << errorFile << ")\n";
+    }
+}
+
+
+/***
+ * This reads how much memory the process has in use
+ * @return the resident set size in KB (0 where it cannot be read)
+ */
+static long residentKB()
+{
+#ifdef __linux__
+    ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    if (statm >> pages >> resident)
+        return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+    return 0;
+}
+
+
+/***
+ * This compiles program after program holding as little at once as the front end can
+ * (lexing on demand, adding each declaration to the AST once it is parsed and resolving
+ * its names), freeing everything after each compile. Every program is the same size but
+ * has names of its own, so the interner sees new names each time. Once the first
+ * compiles have warmed up the heap and the arenas' block pool the memory in use should
+ * stay flat
+ * @param outputFile the file that gets the results
+ * @param errorFile the file that gets the token output and the CST errors (there should
+ * not be any)
+ */
+void runMemoryBenchmark(const string& outputFile, const string& errorFile)
+{
+    ofstream outFS;
+    if (!openResults(outFS, outputFile))
+        return;
+    outFS << "\nMEMORY BENCHMARK\n";
+    outFS << setw(12) << "compiles" << setw(12) << "RSS KB" << setw(14) << "AST bytes\n";
+
+    long firstKB = 0, lastKB = 0;
+    for (int compiles = 1; compiles <= MEMORY_COMPILES; compiles++)
+    {
+        // the names of the last run are dropped
+        interner::global().reset();
+        string source = generateManyFunctions(MEMORY_FUNCTIONS, PARALLEL_FUNCTION_STATEMENTS, compiles);
+        tokenBuffer * TB = createTokenStream(source, errorFile);
+        auto * ST = new symbolTable();
+        auto * ast = new AST(ST);
+        auto * cst = new CST(TB->begin(), errorFile, ST, ast);
+        bool failed = TB->failed() || cst->hasErrors();
+        if (!failed)
+            resolver(ST).resolve(ast->declarations());
+        size_t astBytes = ast->bytesUsed();
+
+        delete cst;
+        delete ast;
+        delete ST;
+        delete TB;
+        if (failed)
+        {
+            outFS << "    (the generated program had errors, see " << errorFile << ")\n";
+            return;
+        }
+
+        if (compiles % MEMORY_CHECKPOINT == 0)
+        {
+            lastKB = residentKB();
+            if (!firstKB)
+                firstKB = lastKB;
+            outFS << setw(12) << compiles << setw(12) << lastKB << setw(13) << astBytes << endl;
+        }
+    }
+
+    if (!firstKB)
+        outFS << "RSS CANNOT BE READ ON THIS SYSTEM\n";
+    else if (lastKB - firstKB <= MEMORY_SLACK_KB)
+        outFS << "RSS STAYED FLAT\n";
+    else
+        outFS << "RSS GREW BY " << lastKB - firstKB << " KB\n";
+}
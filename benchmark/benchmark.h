@@ -0,0 +1,22 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_BENCHMARK_H
+#define ASSIGNMENT5_BENCHMARK_H
+#include <string>
+using namespace std;
+
+
+// These are run from the driver, each one writes its timings to the output file and the
+// errors of the programs it compiles to the error file. The programs they build are
+// generated in memory so no input files are needed
+
+void runConstructionBenchmark(const string& outputFile, const string& errorFile);
+void runParallelParseBenchmark(const string& outputFile, const string& errorFile);
+void runIncrementalBenchmark(const string& outputFile, const string& errorFile);
+void runSymbolTableBenchmark(const string& outputFile, const string& errorFile);
+void runMemoryBenchmark(const string& outputFile, const string& errorFile);
+
+
+#endif //ASSIGNMENT5_BENCHMARK_H
@@ -0,0 +1,126 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "diagnostics.h"
+using namespace std;
+
+
+/***
+ * This is how an error is written: the lead, " on line " and the line number, the text,
+ * then the name and the text after it for the errors that are about a name
+ */
+struct diagnosticFormat {
+    const char * lead;
+    const char * text;
+    const char * afterName;
+};
+
+// indexed by code (the messages are the ones the parser has always written)
+static const diagnosticFormat DIAGNOSTIC_FORMATS[DG_COUNT] = {
+    {"Syntax error", ": INVALID STATEMENT\n", ""},
+    {"Syntax error", ": EXPECTED SINGLE QUOTE\n", ""},
+    {"Syntax error", ": EXPECTED STRING/END QUOTE\n", ""},
+    {"Syntax error", ": EXPECTED END QUOTE\n", ""},
+    {"Syntax error", ": EXPECTED DOUBLE QUOTE\n", ""},
+    {"Syntax error", ": EXPECTED DOUBLE STRING/END QUOTE\n", ""},
+    {"Syntax error", ": NO ENDING DOUBLE QUOTE\n", ""},
+    {"Syntax error", ": Expected identifier\n", ""},
+    {"Syntax error", ": Expected ASSIGNMENT OPERATOR\n", ""},
+    {"Syntax error", ": Expected SEMICOLON\n", ""},
+    {"Syntax error", ": Expected '{' to start block\n", ""},
+    {"Syntax error", ": Expected '}' to close block\n", ""},
+    {"Syntax error", ": Statement expected but pointer is null\n", ""},
+    {"Syntax error", ": Expected 'printf'\n", ""},
+    {"Syntax error", ": Expected '(' after 'printf'\n", ""},
+    {"Syntax error", ": Expected a quoted string after printf\n", ""},
+    {"Syntax error", ": Expected ')' after printf arguments\n", ""},
+    {"Syntax error", ": Expected ';' after printf statement\n", ""},
+    {"Syntax error", ": Attempted to reference an index of a non-array variable\n", ""},
+    {"Syntax error", ": Expected array index as integer\n", ""},
+    {"Syntax error", ": Expected array index to be a positive integer\n", ""},
+    {"Syntax error", ": Expected array index to fit in an int\n", ""},
+    {"Syntax error", ": Expected closing ']' for array declaration\n", ""},
+    {"Syntax error", ": unknown variable referenced\n", ""},
+    {"Syntax error", ": NO IDENTIFIER AFTER COMMA\n", ""},
+    {"Syntax error", ": Unexpected end of input in iteration statement\n", ""},
+    {"Syntax error", ": Expected '(' after 'while'\n", ""},
+    {"Syntax error", ": Expected ')' after while condition\n", ""},
+    {"Syntax error", ": Expected '(' after 'for'\n", ""},
+    {"Syntax error", ": Expected second ';' in for-loop\n", ""},
+    {"Syntax error", ": Expected ')' after for-loop header\n", ""},
+    {"Syntax error", ": Expected 'for' or 'while' at start of iteration statement\n", ""},
+    {"Syntax error", ": Expected 'return'\n", ""},
+    {"Syntax error", ": Expected ';' at end of return statement\n", ""},
+    {"Syntax error", ": Expected datatype\n", ""},
+    {"Syntax error", ": Expected identifier in declaration\n", ""},
+    {"Syntax error", ": Expected semicolon to end declaration statement\n", ""},
+    {"Syntax error", ": Expected 'if' at start of selection statement\n", ""},
+    {"Syntax error", ": EXPECTED PROCEDURE\n", ""},
+    {"Syntax error", ": EXPECTED FUNCTION\n", ""},
+    {"Syntax error", ": EXPECTED DATATYPE\n", ""},
+    {"Syntax error", ": EXPECTED IDENTIFIER\n", ""},
+    {"Syntax error", ": EXPECTED (\n", ""},
+    {"Syntax error", ": EXPECTED void\n", ""},
+    {"Syntax error", ": EXPECTED )\n", ""},
+    {"Syntax error", ": Expected 'getchar'\n", ""},
+    {"Syntax error", ": Expected '(' after 'getchar'\n", ""},
+    {"Syntax error", ": Expected ')' after 'getchar()'\n", ""},
+    {"Syntax error", ": MISSING CLOSING PARENTHESES\n", ""},
+    {"Syntax error", ": Expected ')'\n", ""},
+    {"Syntax error", ": Expected identifier, integer, or '('\n", ""},
+    {"Syntax error", ": Expected function name\n", ""},
+    {"Syntax error", ": Expected '(' after function name\n", ""},
+    {"Syntax error", ": Expected ')' after function arguments\n", ""},
+    {"Syntax error", ": Expected semicolon after user function\n", ""},
+    {"Syntax error", ": invalid integer\n", ""},
+    {"Syntax error", ": ", " can not be used as the name of a procedure\n"},
+    {"Syntax error", ": ", " can not be used as the name of a function\n"},
+    {"Syntax Error", ": the name ", " cannot be used as it is a reserve word\n"},
+    {"Syntax Error", ": the name ", " cannot be used as it\n is a reserve word\n"},
+    {"Error", ": variable \"", "\" is already defined globally\n"},
+    {"Error", ": variable \"", "\" is already defined locally\n"},
+};
+
+
+/***
+ * This adds an error (it is dropped if the limit was already reached)
+ * @param code the error
+ * @param lineNum the line it was found on
+ * @param name the name it is about (empty if none)
+ */
+void diagnostics::report(diagCode code, int lineNum, internedString name)
+{
+    if (full())
+        return;
+    entries.push_back({lineNum, code, name});
+}
+
+
+/***
+ * This adds the errors of part of a program after the ones already here (up to the limit)
+ * @param other the errors
+ */
+void diagnostics::append(const diagnostics& other)
+{
+    for (const diagnostic& entry : other.entries)
+    {
+        if (full())
+            return;
+        entries.push_back(entry);
+    }
+}
+
+
+/***
+ * This writes every error, one after another
+ * @param outFS the output stream
+ */
+void diagnostics::write(ostream& outFS) const
+{
+    for (const diagnostic& entry : entries)
+    {
+        const diagnosticFormat& format = DIAGNOSTIC_FORMATS[entry.code];
+        outFS << format.lead << " on line " << entry.lineNum << format.text << entry.name << format.afterName;
+    }
+}
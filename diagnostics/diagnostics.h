@@ -0,0 +1,80 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_DIAGNOSTICS_H
+#define ASSIGNMENT5_DIAGNOSTICS_H
+#include "../interner/interner.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+// These are the errors the parser reports, each one has its own message (see
+// DIAGNOSTIC_FORMATS)
+enum diagCode : uint8_t {
+    DG_INVALID_STATEMENT, DG_EXPECTED_SINGLE_QUOTE, DG_EXPECTED_STRING_OR_END_QUOTE,
+    DG_EXPECTED_END_QUOTE, DG_EXPECTED_DOUBLE_QUOTE, DG_EXPECTED_DOUBLE_STRING_OR_END_QUOTE,
+    DG_NO_ENDING_DOUBLE_QUOTE, DG_EXPECTED_IDENTIFIER, DG_EXPECTED_ASSIGNMENT,
+    DG_EXPECTED_SEMICOLON, DG_EXPECTED_BLOCK_START, DG_EXPECTED_BLOCK_END, DG_NULL_STATEMENT,
+    DG_EXPECTED_PRINTF, DG_EXPECTED_PRINTF_OPEN, DG_EXPECTED_PRINTF_STRING,
+    DG_EXPECTED_PRINTF_CLOSE, DG_EXPECTED_PRINTF_SEMICOLON, DG_INDEX_OF_NON_ARRAY,
+    DG_EXPECTED_INTEGER_INDEX, DG_NEGATIVE_INDEX, DG_INDEX_TOO_LARGE, DG_EXPECTED_INDEX_CLOSE,
+    DG_UNKNOWN_VARIABLE, DG_NO_IDENTIFIER_AFTER_COMMA, DG_ITERATION_END_OF_INPUT,
+    DG_EXPECTED_WHILE_OPEN, DG_EXPECTED_WHILE_CLOSE, DG_EXPECTED_FOR_OPEN,
+    DG_EXPECTED_FOR_SEMICOLON, DG_EXPECTED_FOR_CLOSE, DG_EXPECTED_ITERATION, DG_EXPECTED_RETURN,
+    DG_EXPECTED_RETURN_SEMICOLON, DG_EXPECTED_DATATYPE, DG_EXPECTED_DECLARATION_IDENTIFIER,
+    DG_EXPECTED_DECLARATION_SEMICOLON, DG_EXPECTED_IF, DG_EXPECTED_PROCEDURE, DG_EXPECTED_FUNCTION,
+    DG_EXPECTED_FUNCTION_DATATYPE, DG_EXPECTED_NAME, DG_EXPECTED_PARAMETERS_OPEN, DG_EXPECTED_VOID,
+    DG_EXPECTED_PARAMETERS_CLOSE, DG_EXPECTED_GETCHAR, DG_EXPECTED_GETCHAR_OPEN,
+    DG_EXPECTED_GETCHAR_CLOSE, DG_MISSING_CLOSING_PARENTHESIS, DG_EXPECTED_CLOSE_PARENTHESIS,
+    DG_EXPECTED_FACTOR, DG_EXPECTED_FUNCTION_NAME, DG_EXPECTED_CALL_OPEN, DG_EXPECTED_CALL_CLOSE,
+    DG_EXPECTED_CALL_SEMICOLON, DG_INVALID_INTEGER, DG_RESERVED_PROCEDURE_NAME,
+    DG_RESERVED_FUNCTION_NAME, DG_RESERVED_VARIABLE_NAME, DG_RESERVED_PARAMETER_NAME,
+    DG_DEFINED_GLOBALLY, DG_DEFINED_LOCALLY, DG_COUNT
+};
+
+
+/***
+ * This is one error, the line it was found on and the name it is about (if any). It is
+ * only turned into text when the errors are written
+ */
+struct diagnostic {
+    int lineNum;
+    diagCode code;
+    internedString name;
+};
+
+
+/***
+ * This collects the errors of a parse in memory and writes them all at once at the end,
+ * in the order they were reported. Given a limit, the errors after the first limit are
+ * dropped and full() tells the parser to stop
+ */
+class diagnostics {
+
+public:
+    explicit diagnostics(size_t limit = 0): _limit{limit} {}
+
+    void report(diagCode code, int lineNum, internedString name = internedString());
+    void append(const diagnostics& other);
+    void clear() { entries.clear(); }
+    void write(ostream& outFS) const;
+
+    [[nodiscard]] bool empty() const { return entries.empty(); }
+    [[nodiscard]] size_t count() const { return entries.size(); }
+    [[nodiscard]] size_t limit() const { return _limit; }
+    [[nodiscard]] bool full() const { return _limit && entries.size() >= _limit; }
+    [[nodiscard]] const vector<diagnostic>& all() const { return entries; }
+
+private:
+    vector<diagnostic> entries;
+    size_t _limit; // errors kept before the parse stops (0 for no limit)
+
+};
+
+
+#endif //ASSIGNMENT5_DIAGNOSTICS_H
@@ -0,0 +1,27 @@
+// ***************************************************
+// * Regression: a condition that starts with !      *
+// ***************************************************
+
+procedure main (void)
+{
+  int a;
+
+  a = 1;
+  if ! (a == 1) { a = 2; } printf ("%d\n", a);
+  if ! (a == 2)
+  {
+    a = 3;
+  }
+  while (a < 5)
+  {
+    if ! (a == 4)
+    {
+      a = a + 1;
+    }
+    else
+    {
+      a = 5;
+    }
+  }
+  printf ("%d\n", a);
+}
@@ -0,0 +1,11 @@
+// ***************************************************
+// * Regression: a statement no rule starts with,    *
+// * followed by an invalid integer                  *
+// ***************************************************
+
+procedure main (void)
+{
+  int a;
+  = 0;
+  a = 1x;
+}
@@ -0,0 +1,13 @@
+// ***************************************************
+// * Regression: statements no rule starts with      *
+// ***************************************************
+
+= 1;
+procedure main (void)
+{
+  int a;
+  = 0;
+  while (a < 1)
+    ) a = 1;
+  a = 2;
+}
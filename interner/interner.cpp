@@ -0,0 +1,162 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "interner.h"
+#include "../tokenize/keywords.h"
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+using namespace std;
+
+
+/***
+ * This sets up an empty table and interns the grammar keywords, special tokens and
+ * reserved names so that they get their fixed IDs
+ */
+interner::interner(): shards{new shard[INTERNER_SHARDS]}, pages{new atomic<string_view *>[INTERNER_MAX_PAGES]}
+{
+    for (uint32_t idx = 0; idx < INTERNER_MAX_PAGES; idx++)
+        pages[idx].store(nullptr, memory_order_relaxed);
+
+    for (uint32_t word = 0; word < KW_COUNT; word++)
+        seed(KEYWORD_TITLES[word], keywordId((keywordKind) word));
+    for (uint32_t kind = TK_L_PAREN; kind < TK_COUNT; kind++)
+        seed(POSSIBLE_TOKENS[kind - TK_L_PAREN], punctuatorId((tokenKind) kind));
+    for (string_view name : RESERVED_NAMES)
+        seed(name, count.load(memory_order_relaxed));
+    fixed = count.load(memory_order_relaxed);
+}
+
+
+/***
+ * Destructor (frees the pages of the ID to text table, the shards free their own text)
+ */
+interner::~interner()
+{
+    for (uint32_t idx = 0; idx < INTERNER_MAX_PAGES; idx++)
+        delete[] pages[idx].load(memory_order_relaxed);
+}
+
+
+/***
+ * This drops every spelling interned since the table was set up (their IDs and text
+ * are no longer valid), so a batch of compilations does not keep the names of the ones
+ * before it. Nothing may use the table while it is reset
+ */
+void interner::reset()
+{
+    for (uint32_t idx = 0; idx < INTERNER_SHARDS; idx++)
+    {
+        shard& part = shards[idx];
+        for (auto entry = part.ids.begin(); entry != part.ids.end(); )
+            entry = entry->second >= fixed ? part.ids.erase(entry) : ++entry;
+        part.ids.rehash(0);
+        // the fixed words are constants, every block holds dropped text
+        part.blocks.clear();
+        part.block = nullptr;
+        part.blockUsed = INTERNER_BLOCK_BYTES;
+    }
+    // the pages only the dropped IDs used are freed
+    uint32_t kept = (fixed + INTERNER_PAGE_SIZE - 1) / INTERNER_PAGE_SIZE;
+    for (uint32_t idx = kept; idx < INTERNER_MAX_PAGES; idx++)
+        delete[] pages[idx].exchange(nullptr, memory_order_relaxed);
+    count.store(fixed, memory_order_relaxed);
+}
+
+
+/***
+ * This interns one of the fixed words (the text is a constant so it is not copied)
+ * @param text the word
+ * @param expectedId the ID it has to get
+ */
+void interner::seed(string_view text, uint32_t expectedId)
+{
+    shard& part = shards[hash<string_view>{}(text) % INTERNER_SHARDS];
+    uint32_t id = count.fetch_add(1, memory_order_relaxed);
+    assert(id == expectedId);
+    (void) expectedId;
+
+    if (!pages[id / INTERNER_PAGE_SIZE].load(memory_order_relaxed))
+        pages[id / INTERNER_PAGE_SIZE].store(new string_view[INTERNER_PAGE_SIZE], memory_order_release);
+    pages[id / INTERNER_PAGE_SIZE].load(memory_order_relaxed)[id % INTERNER_PAGE_SIZE] = text;
+    part.ids.emplace(text, id);
+}
+
+
+/***
+ * This gets the ID of a spelling, giving it a new one the first time it is seen
+ * @param text the spelling
+ * @return its ID
+ */
+uint32_t interner::intern(string_view text)
+{
+    // keywords and special tokens are found in the perfect hash without taking a lock
+    const keywordEntry& entry = lookupKeyword(text);
+    if (entry.word != KW_NONE)
+        return keywordId(entry.word);
+    if (entry.kind != TK_UNKNOWN)
+        return punctuatorId(entry.kind);
+
+    return add(text);
+}
+
+
+/***
+ * This looks a spelling up in its shard and copies it into the table if it is new
+ * @param text the spelling
+ * @return its ID (length_error is thrown if the table is full)
+ */
+uint32_t interner::add(string_view text)
+{
+    shard& part = shards[hash<string_view>{}(text) % INTERNER_SHARDS];
+    lock_guard<mutex> guard(part.lock);
+
+    auto found = part.ids.find(text);
+    if (found != part.ids.end())
+        return found->second;
+
+    uint32_t id = count.fetch_add(1, memory_order_relaxed);
+    uint32_t page = id / INTERNER_PAGE_SIZE;
+    if (page >= INTERNER_MAX_PAGES)
+    {
+        count.fetch_sub(1, memory_order_relaxed);
+        throw length_error("too many distinct names");
+    }
+
+    // copy the text into the shard's current block (long text gets a block of its own)
+    char * copy;
+    if (text.size() > INTERNER_BLOCK_BYTES / 4)
+    {
+        part.blocks.emplace_back(new char[text.size()]);
+        copy = part.blocks.back().get();
+    }
+    else
+    {
+        if (part.blockUsed + text.size() > INTERNER_BLOCK_BYTES)
+        {
+            part.blocks.emplace_back(new char[INTERNER_BLOCK_BYTES]);
+            part.block = part.blocks.back().get();
+            part.blockUsed = 0;
+        }
+        copy = part.block + part.blockUsed;
+        part.blockUsed += text.size();
+    }
+    memcpy(copy, text.data(), text.size());
+    string_view stored(copy, text.size());
+
+    // the first shard to need a page makes it, any other shard that raced it uses that one
+    string_view * entries = pages[page].load(memory_order_acquire);
+    if (!entries)
+    {
+        auto * made = new string_view[INTERNER_PAGE_SIZE];
+        if (pages[page].compare_exchange_strong(entries, made, memory_order_acq_rel))
+            entries = made;
+        else
+            delete[] made;
+    }
+    entries[id % INTERNER_PAGE_SIZE] = stored;
+    part.ids.emplace(stored, id);
+    return id;
+}
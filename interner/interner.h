@@ -0,0 +1,150 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_INTERNER_H
+#define ASSIGNMENT5_INTERNER_H
+#include "../tokenize/tokenKind.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+
+const uint32_t INTERNER_SHARDS = 64; // independently locked parts of the table
+const uint32_t INTERNER_PAGE_SIZE = 4096; // IDs per page of the ID to text table
+const uint32_t INTERNER_MAX_PAGES = 1 << 14;
+const size_t INTERNER_BLOCK_BYTES = 1 << 16; // size of each block the text is copied into
+
+// names the parser matches that are not grammar keywords, they are interned right after
+// the special tokens so that a reset keeps them
+constexpr string_view RESERVED_NAMES[] = {"getChar"};
+
+
+// The grammar keywords and special tokens are interned first, in the order of KEYWORD_TITLES
+// and then POSSIBLE_TOKENS, so their IDs are known without looking anything up (the empty
+// string is ID 0)
+constexpr uint32_t keywordId(keywordKind word) { return word; }
+constexpr uint32_t punctuatorId(tokenKind kind) { return (uint32_t) KW_COUNT + (uint32_t) (kind - TK_L_PAREN); }
+
+// the special token an ID is the text of (TK_UNKNOWN if it is not one), the parser
+// matches text against special tokens with this instead of comparing strings
+constexpr tokenKind punctuatorKind(uint32_t id)
+{
+    return id >= punctuatorId(TK_L_PAREN) && id < punctuatorId(TK_COUNT) ?
+           (tokenKind) (TK_L_PAREN + id - punctuatorId(TK_L_PAREN)) : TK_UNKNOWN;
+}
+
+
+/***
+ * This gives every distinct spelling in a program a small ID that never changes, so two
+ * names can be compared by comparing their IDs. It is shared by every stage (and every
+ * thread, the table is split into shards that are locked separately) and the text it
+ * hands out stays valid until the table is reset. String literals are never interned,
+ * nothing looks them up by ID (see internedString::literal)
+ */
+class interner {
+
+public:
+    interner();
+    ~interner();
+
+    uint32_t intern(string_view text);
+    void reset();
+    [[nodiscard]] string_view text(uint32_t id) const;
+    [[nodiscard]] uint32_t size() const { return count.load(memory_order_relaxed); }
+
+    static interner& global();
+
+private:
+    struct shard {
+        mutex lock;
+        unordered_map<string_view, uint32_t> ids;
+        vector<unique_ptr<char[]>> blocks;
+        char * block = nullptr; // block short text is being copied into
+        size_t blockUsed = INTERNER_BLOCK_BYTES;
+    };
+
+    uint32_t add(string_view text);
+    void seed(string_view text, uint32_t expectedId);
+
+    unique_ptr<shard[]> shards;
+    unique_ptr<atomic<string_view *>[]> pages;
+    atomic<uint32_t> count{0};
+    uint32_t fixed = 0; // number of IDs the table was set up with (a reset keeps them)
+
+};
+
+
+/***
+ * This is an interned spelling, its ID plus a view of its text. Equality only compares
+ * the IDs. A literal (the text of a string literal) is not in the table, its ID is 0 and
+ * whoever made it owns the text
+ */
+class internedString {
+
+public:
+    internedString(): _text{""}, _length{0}, _id{0} {}
+    internedString(string_view text): internedString(fromId(interner::global().intern(text))) {}
+    internedString(const char * text): internedString(string_view(text)) {}
+    internedString(const string& text): internedString(string_view(text)) {}
+
+    static internedString fromId(uint32_t id);
+    static internedString literal(string_view text) { return {text.data(), (uint32_t) text.size(), 0}; }
+
+    [[nodiscard]] uint32_t id() const { return _id; }
+    [[nodiscard]] string_view view() const { return {_text, _length}; }
+    [[nodiscard]] string str() const { return string(_text, _length); }
+    [[nodiscard]] bool empty() const { return _length == 0; }
+
+    bool operator==(const internedString& other) const { return _id == other._id; }
+    bool operator!=(const internedString& other) const { return _id != other._id; }
+
+private:
+    internedString(const char * text, uint32_t length, uint32_t id): _text{text}, _length{length}, _id{id} {}
+
+    const char * _text;
+    uint32_t _length;
+    uint32_t _id;
+
+};
+
+
+/***
+ * This gets the table shared by the whole front end
+ * @return the table
+ */
+inline interner& interner::global()
+{
+    static interner table;
+    return table;
+}
+
+
+/***
+ * This gets the text of an ID
+ * @param id an ID handed out by intern
+ * @return the text
+ */
+inline string_view interner::text(uint32_t id) const
+{
+    return pages[id / INTERNER_PAGE_SIZE].load(memory_order_acquire)[id % INTERNER_PAGE_SIZE];
+}
+
+
+inline internedString internedString::fromId(uint32_t id)
+{
+    string_view text = interner::global().text(id);
+    return {text.data(), (uint32_t) text.size(), id};
+}
+
+inline ostream& operator<<(ostream& outFS, const internedString& name) { return outFS << name.view(); }
+
+
+#endif //ASSIGNMENT5_INTERNER_H
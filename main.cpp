@@ -4,9 +4,19 @@
 #include "tokenize/tokenList.h"
 #include "CST/CST.h"
 #include "AST/AST.h"
+#include "resolver/resolver.h"
+#include "benchmark/benchmark.h"
 using namespace std;
 
 
+// values that run a benchmark instead of the test files
+const int CONSTRUCTION_BENCHMARK = 7;
+const int PARALLEL_PARSE_BENCHMARK = 8;
+const int INCREMENTAL_BENCHMARK = 9;
+const int SYMBOL_TABLE_BENCHMARK = 10;
+const int MEMORY_BENCHMARK = 11;
+
+
 /***
  * Driver program
  */
@@ -15,11 +25,28 @@ int main() {
     string initInput = "init input/programming_assignment_5-test_file_1.c";
     string tokenInput = "token input/input1.txt";
     string outputFile = "output/output1.txt";
-    int userNum, numTests = 5;
+    int userNum, numTests = 8;
+    // pull tokens from the lexer as the parser needs them instead of lexing the whole
+    // program first (only a small window of tokens is held at once)
+    bool lazyTokens = true;
+    // add each declaration to the AST as soon as it is parsed and free its CST nodes
+    // instead of building the whole CST first. Only one declaration's CST is held at once,
+    // but it is not faster (each declaration is still parsed into a CST that the AST is
+    // built from, see the construction benchmark) and there is no CST to output
+    bool streamAST = false;
+    // parse the functions and procedures of a program at the same time on the shared
+    // thread pool (the whole program is lexed before parsing starts)
+    bool parallelParse = false;
+    // stop parsing once this many errors were found (0 to report all of them)
+    size_t maxErrors = 0;
 
     cout << "\nENTER A VALUE (1-5) TO TEST A SINGLE FILE OR 6 (or another larger value) TO TEST THEM ALL\n";
+    cout << "(" << CONSTRUCTION_BENCHMARK << " RUNS THE CST/AST CONSTRUCTION BENCHMARK, ";
+    cout << PARALLEL_PARSE_BENCHMARK << " THE PARALLEL PARSE BENCHMARK, " << INCREMENTAL_BENCHMARK;
+    cout << " THE INCREMENTAL BENCHMARK, " << SYMBOL_TABLE_BENCHMARK << " THE SYMBOL TABLE BENCHMARK, ";
+    cout << MEMORY_BENCHMARK << " THE MEMORY BENCHMARK)\n";
 //    cin >> userNum;
-    userNum = 11;
+    userNum = 6;
 
     if (userNum <= 5)
     {
@@ -32,14 +59,36 @@ int main() {
             } else {
                 adjustFiles(initInput, tokenInput, outputFile, idx);
             }
-            removeComments(initInput, tokenInput);
-            tokenList *TL = createTokenList(tokenInput, "output/tokenTest");
+            // strip the comments and tokenize in memory (no intermediate file)
+            string source;
+            removeComments(readSource(initInput), source, initInput);
+            tokenBuffer *TB = lazyTokens ? createTokenStream(source, "output/tokenTest")
+                                         : createTokenBuffer(source, "output/tokenTest");
+            if (!TB) {
+                cout << "CHECK output/tokenTest FOR ERROR(S)\n";
+                return 1;
+            }
             auto *ST = new symbolTable();
-            auto * cst = new CST(TL->head(), outputFile, ST);
-            auto * ast = new AST(cst, ST);
+            auto * ast = streamAST ? new AST(ST) : nullptr;
+            auto * cst = new CST(TB->begin(), outputFile, ST, ast,
+                                 parallelParse ? &threadPool::shared() : nullptr, maxErrors);
+            if (!streamAST)
+                ast = new AST(cst, ST);
 
+            // a program that could not be lexed is reported the way createTokenBuffer
+            // reports it, whichever kind of token buffer it was read into
+            if (TB->failed()) {
+                cout << "CHECK output/tokenTest FOR ERROR(S)\n";
+                delete cst;
+                delete ast;
+                delete ST;
+                delete TB;
+                return 1;
+            }
             if (!cst->hasErrors()) {
                 cout << "SUCCESSFUL\n";
+                // give the variables their frame slots and bind the names in the AST
+                resolver(ST).resolve(ast->declarations());
 //                ST->output(outputFile);
                 ast->output(outputFile);
 //                cst->outputTraversal(outputFile);
@@ -48,11 +97,44 @@ int main() {
             }
 
             cout << "OUTPUT CAN BE FOUND AT " << outputFile << endl << endl;
+            // the AST's arena frees its nodes, the symbol table its nodes and lists
+            delete cst;
+            delete ast;
+            delete ST;
+            delete TB;
 
     }
 
+    else if (userNum == CONSTRUCTION_BENCHMARK)
+    {
+        runConstructionBenchmark("output/benchmark.txt", "output/benchmarkErrors.txt");
+    }
+
+    else if (userNum == PARALLEL_PARSE_BENCHMARK)
+    {
+        runParallelParseBenchmark("output/benchmark.txt", "output/benchmarkErrors.txt");
+    }
+
+    else if (userNum == INCREMENTAL_BENCHMARK)
+    {
+        runIncrementalBenchmark("output/benchmark.txt", "output/benchmarkErrors.txt");
+    }
+
+    else if (userNum == SYMBOL_TABLE_BENCHMARK)
+    {
+        runSymbolTableBenchmark("output/benchmark.txt", "output/benchmarkErrors.txt");
+    }
+
+    else if (userNum == MEMORY_BENCHMARK)
+    {
+        runMemoryBenchmark("output/benchmark.txt", "output/benchmarkErrors.txt");
+    }
+
     else {
         for (int i = 1; i <= numTests; i++) {
+            // each test file starts with only the fixed names interned (the names of
+            // the one before it are dropped)
+            interner::global().reset();
             cout << "TEST #" << i << endl;
             string idx = to_string(i);
             if (idx.size() == 1) {
@@ -62,14 +144,36 @@ int main() {
             } else {
                 adjustFiles(initInput, tokenInput, outputFile, idx);
             }
-            removeComments(initInput, tokenInput);
-            tokenList *TL = createTokenList(tokenInput, "output/tokenTest");
+            // strip the comments and tokenize in memory (no intermediate file)
+            string source;
+            removeComments(readSource(initInput), source, initInput);
+            tokenBuffer *TB = lazyTokens ? createTokenStream(source, "output/tokenTest")
+                                         : createTokenBuffer(source, "output/tokenTest");
+            if (!TB) {
+                cout << "CHECK output/tokenTest FOR ERROR(S)\n";
+                continue;
+            }
             auto *ST = new symbolTable();
-            auto * cst = new CST(TL->head(), outputFile, ST);
-            auto * ast = new AST(cst, ST);
+            auto * ast = streamAST ? new AST(ST) : nullptr;
+            auto * cst = new CST(TB->begin(), outputFile, ST, ast,
+                                 parallelParse ? &threadPool::shared() : nullptr, maxErrors);
+            if (!streamAST)
+                ast = new AST(cst, ST);
 
+            // a program that could not be lexed is reported the way createTokenBuffer
+            // reports it, whichever kind of token buffer it was read into
+            if (TB->failed()) {
+                cout << "CHECK output/tokenTest FOR ERROR(S)\n";
+                delete cst;
+                delete ast;
+                delete ST;
+                delete TB;
+                continue;
+            }
             if (!cst->hasErrors()) {
                 cout << "SUCCESSFUL\n";
+                // give the variables their frame slots and bind the names in the AST
+                resolver(ST).resolve(ast->declarations());
 //                ST->output(outputFile);
                 ast->output(outputFile);
 //                cst->outputTraversal(outputFile);
@@ -78,6 +182,11 @@ int main() {
             }
 
             cout << "OUTPUT CAN BE FOUND AT " << outputFile << endl << endl;
+            // the AST's arena frees its nodes, the symbol table its nodes and lists
+            delete cst;
+            delete ast;
+            delete ST;
+            delete TB;
         }
     }
 
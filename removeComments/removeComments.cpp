@@ -2,6 +2,13 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <string_view>
+#include "removeComments.h"
+#include "../simdScan/simdScan.h"
+#include "../threadPool/threadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 using namespace std;
 
 /***
@@ -15,7 +22,7 @@ using namespace std;
  * 7: c style error state
  */
 
-void checkState(const char& currentChar, const char& prevChar, int& state, const int& idx, const string& CL)
+void checkState(const char& currentChar, const char& prevChar, int& state, const int& idx, string_view CL)
 {
 
     switch(state)
@@ -25,7 +32,7 @@ void checkState(const char& currentChar, const char& prevChar, int& state, const
             if (currentChar == '/')
             {
                 // current character is not the end of the current line
-                if (idx + 1 < CL.size())
+                if ((size_t) idx + 1 < CL.size())
                 {
                     char nextChar = CL.at(idx + 1);
                     // check if this is the beginning of comment(s)
@@ -91,78 +98,432 @@ void checkState(const char& currentChar, const char& prevChar, int& state, const
 }
 
 
-void removeComments(const string& inputFile, const string& outputFile)
+/***
+ * This reads an entire file into memory so the front end can work on a buffer
+ * instead of reopening files between stages
+ * @param inputFile the file to be read
+ * @return the contents of the file
+ */
+string readSource(const string& inputFile)
 {
     ifstream inFS;
-    ofstream outFS;
-    string currentLine;
-    stringstream lineStream;
-    int currentLineNum = 1, startCommNum = 0, stateNum = 0;
-    char currentChar, prevChar = '\0';
+    stringstream buffer;
 
     inFS.open(inputFile);
-    outFS.open(outputFile);
 
-    // ensure both files opened correctly
-    if (!inFS.is_open() || !outFS.is_open())
+    if (!inFS.is_open())
     {
-        string file;
-        if (!outFS)
-            file = outputFile;
-        else
-            file = inputFile;
-        cout << "ERROR OPENING FILE " << file << endl;
+        cout << "ERROR OPENING FILE " << inputFile << endl;
         exit(1);
     }
 
-    while (getline(inFS, currentLine))
+    buffer << inFS.rdbuf();
+    inFS.close();
+    return buffer.str();
+}
+
+
+/***
+ * This pulls the next line out of a buffer the same way getline does on a file
+ * (the newline is dropped and a missing newline at the end of the buffer still
+ * produces a final line)
+ * @param source the buffer being split
+ * @param pos the current position in the buffer (moved past the line)
+ * @param line holds the line that was found
+ * @return true if a line was found, false if the buffer is exhausted
+ */
+bool nextLine(string_view source, size_t& pos, string_view& line)
+{
+    if (pos >= source.size())
+        return false;
+
+    size_t end = source.find('\n', pos);
+    if (end == string_view::npos)
+        end = source.size();
+
+    line = source.substr(pos, end - pos);
+    pos = end + 1;
+    return true;
+}
+
+
+/***
+ * This splits a buffer into chunks that start at the beginning of a line, so the
+ * chunks can be worked on at the same time
+ * @param source the buffer being split
+ * @param chunkCount the number of chunks wanted (fewer are made if there are not
+ * enough lines)
+ * @return the start of every chunk followed by the size of the buffer
+ */
+vector<size_t> splitLines(string_view source, size_t chunkCount)
+{
+    vector<size_t> starts = {0};
+    for (size_t idx = 1; idx < chunkCount; idx++)
     {
+        // move the boundary forward to the start of the next line
+        size_t newline = source.find('\n', max(starts.back(), idx * source.size() / chunkCount));
+        if (newline == string_view::npos || newline + 1 >= source.size())
+            break;
+        if (newline + 1 > starts.back())
+            starts.push_back(newline + 1);
+    }
+    starts.push_back(source.size());
+    return starts;
+}
 
-        for (int idx = 0; idx < currentLine.size(); idx++)
+
+/***
+ * This handles a run of chars that cannot change the state in one step instead of
+ * calling checkState for each of them (the chars are copied, or replaced with spaces
+ * in a comment)
+ * @param line the current line
+ * @param idx index of the first char of the run
+ * @param state the current state
+ * @param out where the line is being written
+ * @return index of the first char that has to go through checkState
+ */
+static size_t skipRun(string_view line, size_t idx, int state, char * out)
+{
+    size_t end = idx;
+    switch (state)
+    {
+        // only /, quotes (and * before a /) can leave the initial state
+        case 0:
+            end = findCommentDelimiter(line, idx);
+            memcpy(out + idx, line.data() + idx, end - idx);
+            break;
+        // the rest of the line is a c++ style comment
+        case 2:
+            end = line.size();
+            memset(out + idx, ' ', end - idx);
+            break;
+        // a c style comment only ends at a / right after a *
+        case 3:
+            end = findChar(line, idx, '/');
+            while (end < line.size() && (end == 0 || line[end - 1] != '*'))
+                end = findChar(line, end + 1, '/');
+            memset(out + idx, ' ', end - idx);
+            break;
+        // quotes end at the next matching quote
+        case 4: case 5:
+            end = findChar(line, idx, state == 4 ? '\'' : '\"');
+            memcpy(out + idx, line.data() + idx, end - idx);
+            break;
+        default:
+            break;
+    }
+    return end;
+}
+
+
+/***
+ * This removes the comments from a single line, every char of the line (and its newline)
+ * is written to the same column of out, comments are replaced with spaces
+ * @param line the line without its newline
+ * @param stateNum the current state, it is carried to the next line
+ * @param lineNum number of the line (for error messages)
+ * @param startCommNum set to the line number when a comment starts or an error is found
+ * @param out where the line is written (line.size() + 1 chars)
+ * @return index in the line of a c style error, or -1 if there is none
+ */
+static int stripLine(string_view line, int& stateNum, int lineNum, int& startCommNum, char * out)
+{
+    char currentChar, prevChar = '\0';
+
+    for (size_t idx = 0; idx < line.size(); idx++)
+    {
+        // skip ahead to the next char that can change the state
+        size_t runEnd = skipRun(line, idx, stateNum, out);
+        if (runEnd == line.size())
+            break;
+        if (runEnd > idx)
+        {
+            prevChar = line[runEnd - 1];
+            idx = runEnd;
+        }
+
+        currentChar = line[idx];
+        checkState(currentChar, prevChar, stateNum, (int) idx, line);
+        switch(stateNum)
         {
-            currentChar = currentLine.at(idx);
-            checkState(currentChar, prevChar, stateNum, idx, currentLine);
-            switch(stateNum)
+            case 1: // comment starts
             {
-                case 1: // comment starts
-                {
-                    startCommNum = currentLineNum;
-                }
-                case 2: case 3: case 6: // in comment
-                {
-                    outFS << " ";
-                    break;
-                }
-                case 7: // c style error detected !
-                {
-                    startCommNum = currentLineNum;
-                    goto checkError;
-                }
-                default:
-                    outFS << currentChar;
+                startCommNum = lineNum;
+                [[fallthrough]];
+            }
+            case 2: case 3: case 6: // in comment
+            {
+                out[idx] = ' ';
+                break;
             }
+            case 7: // c style error detected !
+            {
+                startCommNum = lineNum;
+                return (int) idx;
+            }
+            default:
+                out[idx] = currentChar;
+        }
 
-            prevChar = currentChar;
+        prevChar = currentChar;
 
+    }
+    // reset the state if it's not the c style state
+    if (stateNum != 3)
+    {
+        stateNum = 0;
+    }
+
+    out[line.size()] = '\n';
+    return -1;
+}
+
+
+/***
+ * This gets the size of a program once its comments are removed (every line ends with
+ * a newline, even the last one)
+ * @param source the program
+ * @return the size
+ */
+static size_t strippedSize(string_view source)
+{
+    return source.size() + (!source.empty() && source.back() != '\n');
+}
+
+
+/***
+ * This prints the unterminated comment error
+ * @param label name used to identify the program
+ * @param startCommNum line the comment started on
+ */
+static void commentError(const string& label, int startCommNum)
+{
+    cout << label << " " << "ERROR: Program contains C-style, unterminated comment on line " << startCommNum << endl;
+}
+
+
+/***
+ * This removes the comments from a program held in memory, comments are replaced
+ * with spaces so the line/column layout of the program is kept (large programs are
+ * stripped in parallel, the output is the same either way)
+ * @param source the program to be stripped
+ * @param output holds the program without comments
+ * @param label name used to identify the program in error messages
+ * @return true if no unterminated comment was found, false if not
+ */
+bool removeComments(string_view source, string& output, const string& label)
+{
+    if (source.size() >= PARALLEL_STRIP_BYTES && threadPool::shared().size() > 1)
+        return removeCommentsParallel(source, output, label);
+
+    string_view currentLine;
+    size_t pos = 0;
+    int currentLineNum = 1, startCommNum = 0, stateNum = 0;
+
+    output.resize(strippedSize(source));
+
+    while (nextLine(source, pos, currentLine))
+    {
+        size_t lineStart = currentLine.data() - source.data();
+        int errorIdx = stripLine(currentLine, stateNum, currentLineNum, startCommNum, &output[lineStart]);
+        // c style error detected, the output stops right before it
+        if (errorIdx >= 0)
+        {
+            output.resize(lineStart + errorIdx);
+            commentError(label, startCommNum);
+            return false;
+        }
+        currentLineNum++;
+    }
+
+    // c style comment not terminated
+    if (stateNum == 3)
+    {
+        commentError(label, startCommNum);
+        return false;
+    }
+
+    return true;
+}
+
+
+// The result of stripping one chunk of lines from one entry state (line numbers are
+// counted from the start of the chunk)
+struct chunkRun {
+    int exitState = 0;
+    int lastCommentLine = 0; // last line a comment started on (0 if none)
+    int errorLine = 0; // line of a c style error (0 if none)
+    size_t errorPos = 0; // position of the error in the program
+    size_t outputEnd = 0; // (entry state 3 only) end of the part of the output in the side buffer
+};
+
+
+/***
+ * This strips one chunk of lines twice at once, once as if the chunk starts outside of a
+ * comment (written straight to the output) and once as if it starts inside a c style
+ * comment (written to a side buffer). A line only passes its state on when it is 3, so as
+ * soon as both runs end a line in the same state the rest of the chunk is the same for
+ * both and the second run stops (usually after the first line)
+ * @param source the whole program
+ * @param begin start of the chunk (the start of a line)
+ * @param end end of the chunk (the start of a line or the end of the program)
+ * @param output the output for the whole program (the chunk is written at begin)
+ * @param side holds the output of the second run up to where it matches the first
+ * @param fromCode result of the run that starts outside of a comment
+ * @param fromComment result of the run that starts inside a comment
+ */
+static void stripChunk(string_view source, size_t begin, size_t end, string& output, string& side,
+                       chunkRun& fromCode, chunkRun& fromComment)
+{
+    string_view currentLine, chunk = source.substr(0, end);
+    size_t pos = begin;
+    int lineNum = 1, codeState = 0, commentState = 3, convergedLine = 0;
+    bool codeDone = false, commentDone = false;
+
+    side.resize(strippedSize(chunk) - begin);
+    while (nextLine(chunk, pos, currentLine) && !(codeDone && commentDone))
+    {
+        size_t lineStart = currentLine.data() - source.data();
+        if (!codeDone)
+        {
+            int errorIdx = stripLine(currentLine, codeState, lineNum, fromCode.lastCommentLine, &output[lineStart]);
+            if (errorIdx >= 0)
+            {
+                fromCode.errorLine = lineNum;
+                fromCode.errorPos = lineStart + errorIdx;
+                codeDone = true;
+            }
         }
-        // reset the state if it's not the c style or error state
-        if (stateNum != 3 && stateNum != 7)
+        if (!commentDone)
         {
-            stateNum = 0;
+            int errorIdx = stripLine(currentLine, commentState, lineNum, fromComment.lastCommentLine,
+                                     &side[lineStart - begin]);
+            if (errorIdx >= 0)
+            {
+                fromComment.errorLine = lineNum;
+                fromComment.errorPos = fromComment.outputEnd = lineStart + errorIdx;
+                commentDone = true;
+            }
+            else
+            {
+                fromComment.outputEnd = lineStart + currentLine.size() + 1;
+                // both runs ended the line in the same state
+                if (!codeDone && codeState == commentState)
+                {
+                    convergedLine = lineNum;
+                    commentDone = true;
+                }
+            }
         }
+        lineNum++;
+    }
+
+    fromCode.exitState = codeState;
+    fromComment.exitState = commentState;
+    // everything after the lines where the runs met comes from the entry 0 run
+    if (convergedLine)
+    {
+        fromComment.exitState = codeState;
+        fromComment.errorLine = fromCode.errorLine;
+        fromComment.errorPos = fromCode.errorPos;
+        if (fromCode.lastCommentLine > convergedLine)
+            fromComment.lastCommentLine = fromCode.lastCommentLine;
+    }
+}
 
-        prevChar = '\0';
-        currentLineNum++;
-        outFS << "\n";
 
+/***
+ * This removes the comments from a large program on the shared thread pool. The program
+ * is split into line aligned chunks and each chunk is stripped from both states a line
+ * can start in (outside of a comment or inside a c style comment), a pass over the chunks
+ * in order then picks the run that matches the state the chunk really starts in
+ * @param source the program to be stripped
+ * @param output holds the program without comments
+ * @param label name used to identify the program in error messages
+ * @return true if no unterminated comment was found, false if not
+ */
+bool removeCommentsParallel(string_view source, string& output, const string& label)
+{
+    threadPool& pool = threadPool::shared();
+    vector<size_t> starts = splitLines(source, min<size_t>(pool.size() * 4,
+                                                           max<size_t>(1, source.size() / MIN_STRIP_CHUNK_BYTES)));
+    size_t chunkCount = starts.size() - 1;
+
+    vector<chunkRun> fromCode(chunkCount), fromComment(chunkCount);
+    vector<string> sides(chunkCount);
+    vector<int> lineCounts(chunkCount);
+
+    output.resize(strippedSize(source));
+    pool.run(chunkCount, [&](size_t chunk)
+    {
+        stripChunk(source, starts[chunk], starts[chunk + 1], output, sides[chunk], fromCode[chunk], fromComment[chunk]);
+        lineCounts[chunk] = (int) count(source.begin() + starts[chunk], source.begin() + starts[chunk + 1], '\n');
+    });
+
+    // prefix pass: follow the real state from chunk to chunk
+    int stateNum = 0, startCommNum = 0, firstLine = 1;
+    for (size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        const chunkRun& run = stateNum == 3 ? fromComment[chunk] : fromCode[chunk];
+        if (stateNum == 3)
+            memcpy(&output[starts[chunk]], sides[chunk].data(), run.outputEnd - starts[chunk]);
+        if (run.lastCommentLine)
+            startCommNum = firstLine - 1 + run.lastCommentLine;
+
+        // c style error detected, the output stops right before it
+        if (run.errorLine)
+        {
+            output.resize(run.errorPos);
+            commentError(label, startCommNum);
+            return false;
+        }
+        stateNum = run.exitState;
+        firstLine += lineCounts[chunk];
+    }
+
+    // c style comment not terminated
+    if (stateNum == 3)
+    {
+        commentError(label, startCommNum);
+        return false;
     }
 
-    checkError:
-    // c style comment not terminated or error in user implementation
-    if (stateNum == 3 || stateNum == 7)
-        cout << outputFile << " " << "ERROR: Program contains C-style, unterminated comment on line " << startCommNum << endl;
+    return true;
+}
+
+
+/***
+ * This removes the comments from a file and writes the result to another file
+ * (thin wrapper around the in-memory version)
+ * @param inputFile the file holding the program
+ * @param outputFile the file that will hold the program without comments
+ */
+void removeComments(const string& inputFile, const string& outputFile)
+{
+    ifstream inFS;
+    ofstream outFS;
+    stringstream buffer;
+    string output;
 
+    inFS.open(inputFile);
+    outFS.open(outputFile);
 
+    // ensure both files opened correctly
+    if (!inFS.is_open() || !outFS.is_open())
+    {
+        string file;
+        if (!outFS)
+            file = outputFile;
+        else
+            file = inputFile;
+        cout << "ERROR OPENING FILE " << file << endl;
+        exit(1);
+    }
+    buffer << inFS.rdbuf();
     inFS.close();
+
+    removeComments(buffer.str(), output, outputFile);
+    outFS << output;
+
     outFS.close();
-}
\ No newline at end of file
+}
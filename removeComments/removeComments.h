@@ -5,10 +5,23 @@
 #ifndef ASSIGNMENT2_REMOVECOMMENTS_H
 #define ASSIGNMENT2_REMOVECOMMENTS_H
 #include <string>
+#include <string_view>
+#include <vector>
 using namespace std;
 
-void checkState(const char& currentChar, const char& prevChar, int& state, const int& idx, const string& CL);
+// programs at least this large are stripped in parallel, and every chunk holds at least
+// this many bytes
+const size_t PARALLEL_STRIP_BYTES = 1 << 20;
+const size_t MIN_STRIP_CHUNK_BYTES = 1 << 18;
+
+
+void checkState(const char& currentChar, const char& prevChar, int& state, const int& idx, string_view CL);
 void removeComments(const string& inputFile, const string& outputFile);
+bool removeComments(string_view source, string& output, const string& label);
+bool removeCommentsParallel(string_view source, string& output, const string& label);
+string readSource(const string& inputFile);
+bool nextLine(string_view source, size_t& pos, string_view& line);
+vector<size_t> splitLines(string_view source, size_t chunkCount);
 
 
 #endif //ASSIGNMENT2_REMOVECOMMENTS_H
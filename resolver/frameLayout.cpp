@@ -0,0 +1,60 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "frameLayout.h"
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+
+/***
+ * This rounds a number of bytes up to a multiple of an alignment
+ * @param bytes the number of bytes
+ * @param align the alignment
+ * @return the rounded number
+ */
+static uint64_t alignUp(uint64_t bytes, uint32_t align)
+{
+    return (bytes + align - 1) / align * align;
+}
+
+
+/***
+ * This adds a variable after the ones already in the frame, variables have to be added
+ * in the order of their slots
+ * @param variable the variable's symbol table node (its slot is already assigned)
+ * @param parameter true if the variable is a parameter
+ */
+void frameLayout::add(stNode * variable, bool parameter)
+{
+    assert(variable->slot().index == (int) _fields.size());
+
+    uint32_t unit = DATA_KIND_BYTES[variable->dataType()];
+    uint64_t length = unit;
+    uint32_t align = unit;
+    if (variable->isArr())
+    {
+        // a parameter's array belongs to the caller and an unsized one is not stored here
+        bool inFrame = !parameter && variable->size() > 0;
+        length = inFrame ? (uint64_t) unit * (uint64_t) variable->size() : REFERENCE_BYTES;
+        align = inFrame ? unit : REFERENCE_BYTES;
+    }
+
+    uint64_t offset = alignUp(used, align);
+    _fields.push_back({variable, offset, length});
+    used = offset + length;
+    _alignment = max(_alignment, align);
+    _bytes = alignUp(used, _alignment);
+}
+
+
+/***
+ * This sets up a new frame, every variable starts out as zero
+ * @param frame the frame (at least bytes() bytes)
+ */
+void frameLayout::initialize(void * frame) const
+{
+    memset(frame, 0, _bytes);
+}
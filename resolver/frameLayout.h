@@ -0,0 +1,59 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_FRAMELAYOUT_H
+#define ASSIGNMENT5_FRAMELAYOUT_H
+#include "../symbolTable/stNode.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+
+// bytes of one value of each data type (a variable without a valid one is laid out as
+// an int)
+const uint32_t DATA_KIND_BYTES[DT_COUNT] = {4, 4, 1, 1, 4};
+const uint32_t REFERENCE_BYTES = sizeof(void *); // an array passed in or of unknown size
+
+
+/***
+ * This is where one variable is stored in a frame
+ */
+struct frameField {
+    stNode * symbol;
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+
+/***
+ * This is the fixed layout of a frame, every variable of the frame at an offset aligned
+ * for its data type (in slot order, see resolver). An array with a size is stored in the
+ * frame itself, an array parameter or an array without a size only holds a reference to
+ * one. A new frame is one block of bytes() bytes aligned to alignment(), every variable
+ * starts out as zero so it is set up by zeroing the block (no template of its bytes is
+ * kept, a frame can be as large as its arrays). Sizes are 64 bits, an int array with
+ * the largest size an int can hold still fits
+ */
+class frameLayout {
+
+public:
+    void add(stNode * variable, bool parameter);
+
+    [[nodiscard]] uint64_t bytes() const { return _bytes; }
+    [[nodiscard]] uint32_t alignment() const { return _alignment; }
+    [[nodiscard]] const vector<frameField>& fields() const { return _fields; }
+    [[nodiscard]] uint64_t offset(int slot) const { return _fields[slot].offset; }
+    void initialize(void * frame) const;
+
+private:
+    vector<frameField> _fields; // by slot index
+    uint64_t used = 0; // bytes up to the end of the last variable
+    uint64_t _bytes = 0; // used padded to the alignment (frames can be laid one after another)
+    uint32_t _alignment = 1;
+
+};
+
+
+#endif //ASSIGNMENT5_FRAMELAYOUT_H
@@ -0,0 +1,200 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "resolver.h"
+using namespace std;
+
+
+/***
+ * Constructor, it numbers the slots of every variable in the symbol table
+ * @param ST the symbol table of the whole program
+ */
+resolver::resolver(symbolTable * ST)
+{
+    this->ST = ST;
+    assignSlots();
+}
+
+
+/***
+ * This gives each parameter and local variable a slot in its function's frame and each
+ * global a slot in the global frame, laying the frames out as it goes, then stores the
+ * size of each function's frame in its node
+ */
+void resolver::assignSlots()
+{
+    // the parameters come first, in the order they are declared
+    for (symbolTable * PL = ST->next(); PL; PL = PL->next())
+    {
+        for (stNode * iter = PL->head(); iter; iter = iter->next())
+        {
+            frameLayout& frame = frames[iter->scope()];
+            iter->slot({LOCAL_FRAME, (int) frame.fields().size()});
+            frame.add(iter, true);
+        }
+    }
+
+    for (stNode * iter = ST->head(); iter; iter = iter == ST->last() ? nullptr : iter->next())
+    {
+        if (!iter->isVariable())
+        {
+            routines.emplace(iter->name().id(), iter); // the first one is kept, like retrieveNode
+            continue;
+        }
+        bool global = iter->scope() == 0;
+        frameLayout& frame = global ? globals : frames[iter->scope()];
+        iter->slot({global ? GLOBAL_FRAME : LOCAL_FRAME, (int) frame.fields().size()});
+        frame.add(iter, false);
+    }
+
+    for (stNode * iter = ST->head(); iter; iter = iter == ST->last() ? nullptr : iter->next())
+    {
+        if (!iter->isVariable())
+            iter->frameSize(frameSize(iter->scope()));
+    }
+}
+
+
+/***
+ * This gets the layout of a function's frame
+ * @param scope scope of the function
+ * @return the layout (an empty one if the function has no variables)
+ */
+const frameLayout& resolver::layout(int scope) const
+{
+    static const frameLayout empty;
+    auto found = frames.find(scope);
+    return found == frames.end() ? empty : found->second;
+}
+
+
+/***
+ * This binds the identifiers of an AST, the statements of a function are in its scope
+ * @param declarations the declarations of the AST
+ */
+void resolver::resolve(const vector<ASTnode *>& declarations)
+{
+    // the global variables already have their slots
+    for (ASTnode * declaration : declarations)
+    {
+        if (declaration->kind != AK_FUNCTION)
+            continue;
+        auto * function = (functionNode *) declaration;
+        resolveNode(function->body, function->symbol ? function->symbol->scope() : 0);
+    }
+}
+
+
+/***
+ * This binds the identifiers in a statement or expression and the ones under it
+ * @param node the node (nothing is done if it is null)
+ * @param scope scope of the function it is in
+ */
+void resolver::resolveNode(ASTnode * node, int scope)
+{
+    if (!node)
+        return;
+
+    switch (node->kind)
+    {
+        case AK_BLOCK:
+            for (ASTnode * statement : ((blockNode *) node)->statements)
+                resolveNode(statement, scope);
+            break;
+        case AK_IF:
+        {
+            auto * statement = (ifNode *) node;
+            resolveNode(statement->condition, scope);
+            resolveNode(statement->thenBranch, scope);
+            resolveNode(statement->elseBranch, scope);
+            break;
+        }
+        case AK_WHILE:
+            resolveNode(((whileNode *) node)->condition, scope);
+            resolveNode(((whileNode *) node)->body, scope);
+            break;
+        case AK_FOR:
+        {
+            auto * loop = (forNode *) node;
+            resolveNode(loop->init, scope);
+            resolveNode(loop->condition, scope);
+            resolveNode(loop->update, scope);
+            resolveNode(loop->body, scope);
+            break;
+        }
+        case AK_RETURN:
+            resolveNode(((returnNode *) node)->value, scope);
+            break;
+        case AK_PRINTF:
+            // the format string is not a name
+            for (ASTnode * arg : ((printfNode *) node)->args)
+                resolveNode(arg, scope);
+            break;
+        case AK_ASSIGN:
+            resolveNode(((assignNode *) node)->target, scope);
+            resolveNode(((assignNode *) node)->value, scope);
+            break;
+        case AK_CALL:
+        {
+            auto * call = (callNode *) node;
+            resolveCallee(call->callee);
+            for (ASTnode * arg : call->args)
+                resolveNode(arg, scope);
+            break;
+        }
+        case AK_INDEX:
+            resolveUse(((indexNode *) node)->array, scope);
+            resolveNode(((indexNode *) node)->index, scope);
+            break;
+        case AK_BINARY:
+            resolveNode(((binaryNode *) node)->left, scope);
+            resolveNode(((binaryNode *) node)->right, scope);
+            break;
+        case AK_UNARY:
+            resolveNode(((unaryNode *) node)->operand, scope);
+            break;
+        case AK_IDENTIFIER:
+            resolveUse((identifierNode *) node, scope);
+            break;
+        // declarations name the symbols they declare, literals and getchar name nothing
+        default:
+            break;
+    }
+}
+
+
+/***
+ * This binds a name used in a scope to the variable it refers to (or the function or
+ * procedure if no variable has the name), names of nothing are left unbound
+ * @param use the identifier
+ * @param scope scope the name is used in
+ */
+void resolver::resolveUse(identifierNode * use, int scope)
+{
+    stNode * symbol = ST->retrieveVariable(use->name, scope);
+    if (symbol)
+    {
+        use->symbol = symbol;
+        use->slot = symbol->slot();
+        resolved++;
+        return;
+    }
+    resolveCallee(use);
+}
+
+
+/***
+ * This binds the name of a function or procedure that is called
+ * @param callee the identifier
+ */
+void resolver::resolveCallee(identifierNode * callee)
+{
+    auto routine = routines.find(callee->name.id());
+    if (routine != routines.end())
+    {
+        callee->symbol = routine->second;
+        callee->slot = frameSlot();
+        resolved++;
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_RESOLVER_H
+#define ASSIGNMENT5_RESOLVER_H
+#include "../AST/AST.h"
+#include "frameLayout.h"
+#include <cstdint>
+#include <unordered_map>
+using namespace std;
+
+
+/***
+ * This is the pass after the AST is built that gives every variable a slot in a frame
+ * and binds every use of a name in the AST to what it names, so running the program can
+ * index its frames instead of looking names up. A function's parameters take the first
+ * slots of its frame and its local variables the ones after them, the globals have a
+ * frame of their own. Identifiers of functions and procedures are bound without a slot.
+ * It also lays out the bytes of every frame (see frameLayout)
+ */
+class resolver {
+
+public:
+    explicit resolver(symbolTable * ST);
+
+    void resolve(const vector<ASTnode *>& declarations);
+
+    [[nodiscard]] int globalFrameSize() const { return (int) globals.fields().size(); }
+    [[nodiscard]] int frameSize(int scope) const { return (int) layout(scope).fields().size(); }
+    [[nodiscard]] const frameLayout& globalLayout() const { return globals; }
+    [[nodiscard]] const frameLayout& layout(int scope) const;
+    [[nodiscard]] size_t resolvedCount() const { return resolved; }
+
+private:
+    void assignSlots();
+    void resolveNode(ASTnode * node, int scope);
+    void resolveUse(identifierNode * use, int scope);
+    void resolveCallee(identifierNode * callee);
+
+    symbolTable * ST;
+    frameLayout globals;
+    unordered_map<int, frameLayout> frames; // each function's frame, by its scope
+    unordered_map<uint32_t, stNode *> routines; // functions and procedures, by name ID
+    size_t resolved = 0; // uses bound so far
+
+};
+
+
+#endif //ASSIGNMENT5_RESOLVER_H
@@ -0,0 +1,462 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "session.h"
+#include "../removeComments/removeComments.h"
+#include "../tokenize/lexer.h"
+#include "../tokenize/keywords.h"
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+using namespace std;
+
+
+/***
+ * This is what a name used in a piece finds in the symbol table before the piece. Each
+ * function has a scope of its own, so the only symbols before a piece that its lookups
+ * can find are the global variables and the functions (see symbolTable::inUse, exists
+ * and retrieveNode)
+ */
+struct nameUse {
+    internedString name;
+    uint8_t globals = 0; // bit 0: a global variable with the name, bit 1: a global array with it
+    bool function = false; // there is a function with the name
+    stNode * found = nullptr; // first global variable or function with the name (null if none)
+    bool foundArr = false;
+};
+
+
+/***
+ * This is a piece of a program, it starts at a top level function or procedure keyword
+ * (or at the start of the program) and runs to the line the next one is on
+ */
+struct programPiece {
+    string text; // the piece without comments
+    char prevChar = '\0'; // last char before the piece (the lexer reads it)
+    int lines = 0; // end of line tokens in the piece
+    int firstScope = 0; // number of functions and procedures before the piece
+    unique_ptr<CST> parser; // holds the piece's nodes
+    unique_ptr<symbolTable> table;
+    diagnostics errors;
+    vector<nameUse> names; // every name the piece uses
+    bool anyGlobal = false; // a global variable was declared before the piece
+    unique_ptr<AST> tree; // null until it is built
+    bool treeNextSibling = false; // the tree was built with the next piece linked as a sibling
+
+    [[nodiscard]] bool hasErrors() const { return parser->hasErrors() || !errors.empty(); }
+};
+
+
+/***
+ * This holds the symbols of the pieces already linked that a later piece can find
+ */
+struct priorNames {
+    unordered_map<uint32_t, uint8_t> globals; // name ID of every global variable (see nameUse)
+    unordered_map<uint32_t, stNode *> functions; // first function node with each name
+    unordered_map<uint32_t, stNode *> named; // first global variable or function node with each name
+    bool anyGlobal = false;
+
+    [[nodiscard]] nameUse find(internedString name) const;
+    bool refresh(programPiece& piece, bool& sameTree) const;
+    void add(symbolTable * table);
+};
+
+
+// a piece of a program's text (see splitPieces)
+struct pieceText {
+    string_view text;
+    char prevChar; // last char before the piece
+};
+
+
+/***
+ * This finds what a name finds in the symbols
+ * @param name the name
+ * @return what it finds
+ */
+nameUse priorNames::find(internedString name) const
+{
+    nameUse use{name};
+    auto bits = globals.find(name.id());
+    if (bits != globals.end())
+        use.globals = bits->second;
+    use.function = functions.count(name.id()) > 0;
+    auto node = named.find(name.id());
+    if (node != named.end())
+    {
+        use.found = node->second;
+        use.foundArr = node->second->isArr();
+    }
+    return use;
+}
+
+
+/***
+ * This checks that the names of a piece find the same symbols before it as they did
+ * when it was parsed, and remembers what they find now
+ * @param piece the piece
+ * @param sameTree set to false if a name finds another node (the piece's AST points at
+ * the nodes its names find, so it has to be built again)
+ * @return true if the piece would be parsed the same way
+ */
+bool priorNames::refresh(programPiece& piece, bool& sameTree) const
+{
+    sameTree = true;
+    if (piece.anyGlobal != anyGlobal)
+        return false;
+    for (nameUse& use : piece.names)
+    {
+        nameUse now = find(use.name);
+        if (now.globals != use.globals || now.function != use.function || !now.found != !use.found ||
+            now.foundArr != use.foundArr)
+            return false;
+        sameTree = sameTree && now.found == use.found;
+        use = now;
+    }
+    return true;
+}
+
+
+/***
+ * This adds the nodes of a piece that later pieces can find
+ * @param table the piece's symbol table
+ */
+void priorNames::add(symbolTable * table)
+{
+    for (stNode * entry = table->head(); entry; entry = entry == table->last() ? nullptr : entry->next())
+    {
+        uint32_t id = entry->name().id();
+        bool function = entry->kind() == SK_FUNCTION;
+        if (entry->scope() == 0)
+        {
+            anyGlobal = true;
+            globals[id] |= entry->isArr() ? 2 : 1;
+        }
+        if (function)
+            functions.emplace(id, entry);
+        if (function || entry->scope() == 0)
+            named.emplace(id, entry);
+    }
+}
+
+
+/***
+ * This checks if a line starts with the function or procedure keyword
+ * @param line the line
+ * @return true if it does
+ */
+static bool startsDefinition(string_view line)
+{
+    size_t start = line.find_first_not_of(" \t");
+    if (start == string_view::npos)
+        return false;
+    size_t end = start;
+    while (end < line.size() && (isalnum((unsigned char) line[end]) || line[end] == '_'))
+        end++;
+    keywordKind word = lookupKeyword(line.substr(start, end - start)).word;
+    return word == KW_FUNCTION || word == KW_PROCEDURE;
+}
+
+
+/***
+ * This splits a program into pieces at the lines that start with a function or procedure
+ * keyword outside of braces. It only looks at the text, a piece that was not split where
+ * the parser would have split it has an error (and is parsed with the rest of the program)
+ * @param program the program without comments
+ * @return the pieces
+ */
+static vector<pieceText> splitPieces(string_view program)
+{
+    vector<pieceText> texts;
+    size_t start = 0, pos = 0;
+    int depth = 0;
+    char prevChar = '\0', lastChar = '\0';
+    string_view line;
+
+    while (true)
+    {
+        size_t lineStart = pos;
+        if (!nextLine(program, pos, line))
+            break;
+        if (depth == 0 && lineStart > start && startsDefinition(line))
+        {
+            texts.push_back({program.substr(start, lineStart - start), prevChar});
+            start = lineStart;
+            prevChar = lastChar;
+        }
+
+        // braces inside quotes do not count
+        char quote = '\0';
+        for (size_t idx = 0; idx < line.size(); idx++)
+        {
+            char curChar = line[idx];
+            if (quote)
+            {
+                if (curChar == '\\')
+                    idx++;
+                else if (curChar == quote)
+                    quote = '\0';
+            }
+            else if (curChar == '"' || curChar == '\'')
+                quote = curChar;
+            else if (curChar == '{')
+                depth++;
+            else if (curChar == '}')
+                depth = max(depth - 1, 0);
+        }
+        if (!line.empty())
+            lastChar = line.back();
+    }
+    if (start < program.size())
+        texts.push_back({program.substr(start), prevChar});
+    return texts;
+}
+
+
+/***
+ * This checks if a piece can be reused for a piece of the edited program
+ * @param piece the piece
+ * @param text the edited program's piece
+ * @return true if the text (and the char before it) did not change
+ */
+static bool sameText(const programPiece& piece, const pieceText& text)
+{
+    return !piece.hasErrors() && piece.prevChar == text.prevChar && piece.text == text.text;
+}
+
+
+/***
+ * Constructor for a session that has not seen a program yet
+ */
+session::session(): tree(&ST) {}
+
+
+/***
+ * Destructor (the pieces own the nodes the whole program's symbol table and AST link)
+ */
+session::~session()
+{
+    ST.release();
+    tree.release();
+}
+
+
+/***
+ * This brings the front end's results up to date with an edited program. Only the
+ * pieces whose text changed are lexed and parsed again, along with the ones whose names
+ * find other symbols before them than they did. A program with a syntax error is parsed
+ * from the first piece with an error to its end, the same way a full run parses it
+ * @param source the program (with comments)
+ * @param outputFile the file that gets the errors
+ * @return false if the program could not be lexed (the error is in the output file)
+ */
+bool session::update(const string& source, const string& outputFile)
+{
+    ofstream outFS(outputFile);
+    if (!outFS.is_open())
+        throw runtime_error("SESSION FILE DID NOT OPEN\n");
+    diagnostics errors;
+
+    string program;
+    removeComments(source, program, outputFile);
+    vector<pieceText> texts = splitPieces(program);
+
+    // only the pieces at the start and end of the program can be matched up with the
+    // pieces from before the edit
+    vector<unique_ptr<programPiece>> old = std::move(pieces);
+    pieces.clear();
+    size_t front = 0, back = 0;
+    while (front < min(texts.size(), old.size()) && sameText(*old[front], texts[front]))
+        front++;
+    while (back < min(texts.size(), old.size()) - front &&
+           sameText(*old[old.size() - 1 - back], texts[texts.size() - 1 - back]))
+        back++;
+
+    ST.release();
+    tree.release();
+    priorNames prior;
+    errorDetected = false;
+    parsed = 0;
+    int lineNum = 1, prevScope = 0;
+    bool rest = false; // the last piece parsed holds the rest of the program
+
+    for (size_t idx = 0; idx < texts.size() && !rest; idx++)
+    {
+        unique_ptr<programPiece> piece;
+        // the symbols before the pieces at the start did not change
+        if (idx < front)
+            piece = std::move(old[idx]);
+        else if (idx >= texts.size() - back)
+        {
+            piece = std::move(old[old.size() - (texts.size() - idx)]);
+            bool sameTree;
+            if (!prior.refresh(*piece, sameTree))
+                piece = nullptr;
+            else if (!sameTree)
+                piece->tree = nullptr;
+        }
+
+        if (piece && piece->firstScope != prevScope)
+        {
+            piece->parser->shiftScopes(prevScope - piece->firstScope);
+            piece->table->shiftScopes(prevScope - piece->firstScope);
+            piece->firstScope = prevScope;
+        }
+        else if (!piece)
+        {
+            piece = parsePiece(texts[idx].text, texts[idx].prevChar, lineNum, prevScope, prior, errors);
+            // the parse of a piece with an error can run into the pieces after it
+            if (piece && piece->hasErrors())
+            {
+                size_t start = texts[idx].text.data() - program.data();
+                piece = parsePiece(string_view(program).substr(start), texts[idx].prevChar, lineNum, prevScope,
+                                   prior, errors);
+                rest = true;
+            }
+            if (!piece)
+            {
+                errorDetected = true;
+                errors.write(outFS);
+                return false;
+            }
+        }
+
+        // the AST is only output for a program without errors
+        errorDetected = piece->hasErrors();
+        if (!pieces.empty() && !errorDetected)
+            buildTree(*pieces.back(), piece.get());
+
+        // the parameter lists are added to the first function node with their name, the
+        // same way insertST adds them
+        symbolTable * table = piece->table.get();
+        ST.link(table);
+        for (stNode * entry = table->head(); entry; entry = entry == table->last() ? nullptr : entry->next())
+        {
+            if (entry->kind() == SK_FUNCTION)
+                entry->addST(nullptr);
+        }
+        prior.add(table);
+        for (symbolTable * PL = table->next(); PL; PL = PL == table->tail() ? nullptr : PL->next())
+        {
+            auto function = prior.functions.find(PL->name().id());
+            if (function != prior.functions.end())
+                function->second->addST(PL);
+        }
+
+        errors.append(piece->errors);
+        lineNum += piece->lines;
+        prevScope = piece->parser->lastScope();
+        pieces.push_back(std::move(piece));
+    }
+
+    if (!errorDetected)
+    {
+        if (!pieces.empty())
+            buildTree(*pieces.back(), nullptr);
+        for (auto& piece : pieces)
+            tree.append(piece->tree.get());
+    }
+    errors.write(outFS);
+    return true;
+}
+
+
+/***
+ * This lexes and parses a piece of a program after the pieces already linked into the
+ * symbol table (so its lookups are answered the way a full run answers them), the
+ * piece's own symbols are then moved out to its table
+ * @param text the piece (without comments)
+ * @param prevChar the last char before the piece
+ * @param lineNum line number at the start of the piece
+ * @param prevScope number of functions and procedures before the piece
+ * @param prior the symbols before the piece
+ * @param diag gets the error if the piece can not be lexed
+ * @return the piece (null if it could not be lexed)
+ */
+unique_ptr<programPiece> session::parsePiece(string_view text, char prevChar, int lineNum, int prevScope,
+                                             const priorNames& prior, diagnostics& diag)
+{
+    auto piece = make_unique<programPiece>();
+    piece->text = text;
+    piece->prevChar = prevChar;
+    piece->firstScope = prevScope;
+
+    // the piece's tokens are only needed while it is parsed (the nodes intern their text)
+    tokenBuffer TB(piece->text);
+    lexer lex(piece->text, &TB, 1, prevChar);
+    if (!lex.run())
+    {
+        diag.report(DG_INVALID_INTEGER, lineNum + lex.lineNumber() - 1);
+        return nullptr;
+    }
+    parsed++;
+
+    stNode * last = ST.last();
+    symbolTable * lastPL = ST.tail();
+    piece->parser = make_unique<CST>(TB.begin(), piece->errors, &ST, lineNum, prevScope);
+    piece->table = make_unique<symbolTable>();
+    piece->table->adopt(&ST, last, lastPL);
+
+    unordered_set<uint32_t> seen;
+    for (tokenIter iter = TB.begin(); iter; iter = iter->next())
+    {
+        if (iter->isEndlToken())
+            piece->lines++;
+        else if (iter->kind() == TK_IDENTIFIER && seen.insert(iter->name().id()).second)
+            piece->names.push_back(prior.find(iter->name()));
+    }
+    piece->anyGlobal = prior.anyGlobal;
+    return piece;
+}
+
+
+/***
+ * This builds the AST of a piece unless the one it has is still right. The last
+ * declaration of a piece ends on the first node of the next piece (see AST::nextNode),
+ * so the tree depends on whether the next piece is linked to it as a sibling
+ * @param piece the piece
+ * @param next the piece after it (null for the last piece)
+ */
+void session::buildTree(programPiece& piece, programPiece * next)
+{
+    bool nextSibling = next && next->parser->pieceHead() && !next->parser->startsLine();
+    if (piece.tree && piece.treeNextSibling == nextSibling)
+        return;
+
+    // a flat copy of the piece (and of the next one if the piece runs into it)
+    flatCST window;
+    window.append(piece.parser->pieceHead(), piece.parser->pieceTail(), false);
+    uint32_t end = NO_NODE;
+    if (nextSibling)
+        end = window.append(next->parser->pieceHead(), next->parser->pieceTail(), false);
+
+    piece.tree = make_unique<AST>(&ST);
+    cstIter iter = window.root();
+    piece.tree->addDeclarations(iter, end);
+    piece.treeNextSibling = nextSibling;
+}
+
+
+/***
+ * This outputs the CST of the whole program the same way CST::outputTraversal does
+ * @param outputFile the file that gets the CST
+ */
+void session::outputCST(const string& outputFile) const
+{
+    flatCST whole;
+    for (const auto& piece : pieces)
+        whole.append(piece->parser->pieceHead(), piece->parser->pieceTail(), piece->parser->startsLine());
+
+    ofstream outFS;
+    outFS.open(outputFile);
+    if (!outFS.is_open())
+    {
+        cout << "ERROR OPENING " << outputFile << endl;
+        exit(3);
+    }
+    whole.output(outFS);
+    outFS.close();
+}
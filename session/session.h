@@ -0,0 +1,57 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_SESSION_H
+#define ASSIGNMENT5_SESSION_H
+#include "../CST/CST.h"
+#include "../AST/AST.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+struct programPiece;
+struct priorNames;
+
+
+/***
+ * This keeps the front end's results for a program that is edited and run again. The
+ * program is split into pieces at the top level function and procedure keywords, and
+ * each piece keeps its own text, CST, symbol table nodes and AST. After an edit only
+ * the pieces whose text changed are lexed and parsed again. A piece that did not change
+ * is reused as long as the symbols before it that its names could find are the same,
+ * its scopes are shifted if functions were added or removed before it (its line numbers
+ * are never stored, so they need nothing). The symbol table and AST of the whole
+ * program link the pieces' own together, and they are the same as a full run would build
+ */
+class session {
+
+public:
+    session();
+    ~session();
+
+    bool update(const string& source, const string& outputFile);
+    void outputCST(const string& outputFile) const;
+
+    [[nodiscard]] symbolTable * symbols() { return &ST; }
+    [[nodiscard]] AST * ast() { return errorDetected ? nullptr : &tree; }
+    [[nodiscard]] bool hasErrors() const { return errorDetected; }
+    [[nodiscard]] size_t pieceCount() const { return pieces.size(); }
+    [[nodiscard]] size_t parsedCount() const { return parsed; }
+
+private:
+    unique_ptr<programPiece> parsePiece(string_view text, char prevChar, int lineNum, int prevScope,
+                                        const priorNames& prior, diagnostics& diag);
+    void buildTree(programPiece& piece, programPiece * next);
+
+    vector<unique_ptr<programPiece>> pieces;
+    symbolTable ST; // links the pieces' symbol tables together (it does not own their nodes)
+    AST tree; // links the pieces' ASTs together
+    bool errorDetected = false;
+    size_t parsed = 0; // pieces parsed by the last update
+
+};
+
+
+#endif //ASSIGNMENT5_SESSION_H
@@ -0,0 +1,253 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "simdScan.h"
+#include <cstdint>
+#include <cstring>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_SCAN_X86
+#include <immintrin.h>
+#endif
+using namespace std;
+
+
+// Each kind of run says which bytes end it, one byte at a time and for a whole vector
+// (a set bit in the mask is a byte that ends the run)
+
+struct spaceRun {
+    static bool ends(char c) { return c != ' '; }
+#ifdef SIMD_SCAN_X86
+    static uint32_t ends(__m128i bytes)
+    {
+        return ~_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '))) & 0xFFFFu;
+    }
+    __attribute__((target("avx2"))) static uint32_t ends(__m256i bytes)
+    {
+        return ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')));
+    }
+#endif
+};
+
+
+// letters, digits and underscores (bytes above 127 are negative as signed chars so the
+// signed compares leave them out)
+struct wordRun {
+    static bool ends(char c)
+    {
+        char lower = (char) (c | 0x20);
+        return !((lower >= 'a' && lower <= 'z') || (c >= '0' && c <= '9') || c == '_');
+    }
+#ifdef SIMD_SCAN_X86
+    static uint32_t ends(__m128i bytes)
+    {
+        __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                       _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                      _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+        __m128i underscore = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('_'));
+        __m128i word = _mm_or_si128(_mm_or_si128(letter, digit), underscore);
+        return ~_mm_movemask_epi8(word) & 0xFFFFu;
+    }
+    __attribute__((target("avx2"))) static uint32_t ends(__m256i bytes)
+    {
+        __m256i lower = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('0' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), bytes));
+        __m256i underscore = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('_'));
+        __m256i word = _mm256_or_si256(_mm256_or_si256(letter, digit), underscore);
+        return ~(uint32_t) _mm256_movemask_epi8(word);
+    }
+#endif
+};
+
+
+// the chars that can start or end a comment or a quote
+struct delimiterRun {
+    static bool ends(char c) { return c == '/' || c == '\"' || c == '\'' || c == '*'; }
+#ifdef SIMD_SCAN_X86
+    static uint32_t ends(__m128i bytes)
+    {
+        __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('/')),
+                                                  _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\"'))),
+                                     _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\'')),
+                                                  _mm_cmpeq_epi8(bytes, _mm_set1_epi8('*'))));
+        return _mm_movemask_epi8(found);
+    }
+    __attribute__((target("avx2"))) static uint32_t ends(__m256i bytes)
+    {
+        __m256i found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('/')),
+                                                        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\"'))),
+                                        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\'')),
+                                                        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('*'))));
+        return (uint32_t) _mm256_movemask_epi8(found);
+    }
+#endif
+};
+
+
+/***
+ * This scans a run one byte at a time (used for the tail of a run and on cpus without
+ * vector instructions)
+ * @param data the text
+ * @param pos where the run starts
+ * @param size size of the text
+ * @return the index of the first byte that ends the run, or size
+ */
+template <typename run>
+static size_t scanScalar(const char * data, size_t pos, size_t size)
+{
+    while (pos < size && !run::ends(data[pos]))
+        pos++;
+    return pos;
+}
+
+
+#ifdef SIMD_SCAN_X86
+/***
+ * This scans a run 16 bytes at a time
+ * @param data the text
+ * @param pos where the run starts
+ * @param size size of the text
+ * @return the index of the first byte that ends the run, or size
+ */
+template <typename run>
+static size_t scanSSE2(const char * data, size_t pos, size_t size)
+{
+    for (; pos + 16 <= size; pos += 16)
+    {
+        uint32_t mask = run::ends(_mm_loadu_si128((const __m128i *) (data + pos)));
+        if (mask)
+            return pos + __builtin_ctz(mask);
+    }
+    return scanScalar<run>(data, pos, size);
+}
+
+
+/***
+ * This scans a run 32 bytes at a time (the tail is scanned here too instead of calling
+ * the SSE2 version, a jump into non-VEX code with the upper halves of the ymm registers
+ * still dirty costs far more than the scan)
+ * @param data the text
+ * @param pos where the run starts
+ * @param size size of the text
+ * @return the index of the first byte that ends the run, or size
+ */
+template <typename run>
+__attribute__((target("avx2"))) static size_t scanAVX2(const char * data, size_t pos, size_t size)
+{
+    for (; pos + 32 <= size; pos += 32)
+    {
+        uint32_t mask = run::ends(_mm256_loadu_si256((const __m256i *) (data + pos)));
+        if (mask)
+            return pos + __builtin_ctz(mask);
+    }
+    if (pos + 16 <= size)
+    {
+        uint32_t mask = run::ends(_mm_loadu_si128((const __m128i *) (data + pos)));
+        if (mask)
+            return pos + __builtin_ctz(mask);
+        pos += 16;
+    }
+    while (pos < size && !run::ends(data[pos]))
+        pos++;
+    return pos;
+}
+#endif
+
+
+typedef size_t (*scanFunction)(const char *, size_t, size_t);
+
+struct scanners {
+    scanFunction spaces;
+    scanFunction words;
+    scanFunction delimiters;
+    const char * level;
+};
+
+
+/***
+ * This picks the widest scanners the cpu supports (only done once)
+ * @return the scanners
+ */
+static const scanners& pickScanners()
+{
+    static const scanners chosen = []
+    {
+#ifdef SIMD_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return scanners{scanAVX2<spaceRun>, scanAVX2<wordRun>, scanAVX2<delimiterRun>, "avx2"};
+        return scanners{scanSSE2<spaceRun>, scanSSE2<wordRun>, scanSSE2<delimiterRun>, "sse2"};
+#else
+        return scanners{scanScalar<spaceRun>, scanScalar<wordRun>, scanScalar<delimiterRun>, "scalar"};
+#endif
+    }();
+    return chosen;
+}
+
+
+/***
+ * This skips a run of spaces
+ * @param text the text
+ * @param pos where the run starts
+ * @return index of the first char that is not a space, or the size of the text
+ */
+size_t skipSpaces(string_view text, size_t pos)
+{
+    return pickScanners().spaces(text.data(), pos, text.size());
+}
+
+
+/***
+ * This skips a run of letters, digits and underscores (an identifier or a number)
+ * @param text the text
+ * @param pos where the run starts
+ * @return index of the first char that is not part of the run, or the size of the text
+ */
+size_t skipWordChars(string_view text, size_t pos)
+{
+    return pickScanners().words(text.data(), pos, text.size());
+}
+
+
+/***
+ * This finds the next char that can start or end a comment or quote (/, ", ' or *)
+ * @param text the text
+ * @param pos where to start looking
+ * @return index of the char, or the size of the text if there is none
+ */
+size_t findCommentDelimiter(string_view text, size_t pos)
+{
+    return pickScanners().delimiters(text.data(), pos, text.size());
+}
+
+
+/***
+ * This finds the next occurrence of a single char (memchr is already vectorised by the
+ * C library, so it is used for every cpu)
+ * @param text the text
+ * @param pos where to start looking
+ * @param target the char to look for
+ * @return index of the char, or the size of the text if there is none
+ */
+size_t findChar(string_view text, size_t pos, char target)
+{
+    if (pos >= text.size())
+        return text.size();
+    const void * found = memchr(text.data() + pos, target, text.size() - pos);
+    return found ? (const char *) found - text.data() : text.size();
+}
+
+
+/***
+ * This gets the name of the scanners that were picked (for benchmarks)
+ * @return "avx2", "sse2" or "scalar"
+ */
+const char * simdLevel()
+{
+    return pickScanners().level;
+}
@@ -0,0 +1,24 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_SIMDSCAN_H
+#define ASSIGNMENT5_SIMDSCAN_H
+#include <cstddef>
+#include <string_view>
+using namespace std;
+
+
+// These scan a run of bytes 16 (SSE2) or 32 (AVX2) at a time, the widest version the cpu
+// supports is picked the first time one is called (other cpus use a byte at a time loop).
+// Each returns the index of the first byte at or after pos that ends the run, or the size
+// of the text if the run goes to the end
+
+size_t skipSpaces(string_view text, size_t pos);
+size_t skipWordChars(string_view text, size_t pos);
+size_t findCommentDelimiter(string_view text, size_t pos);
+size_t findChar(string_view text, size_t pos, char target);
+const char * simdLevel();
+
+
+#endif //ASSIGNMENT5_SIMDSCAN_H
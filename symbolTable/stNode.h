@@ -4,52 +4,123 @@
 
 #ifndef ASSIGNMENT4_STNODE_H
 #define ASSIGNMENT4_STNODE_H
-#include <string>
-#include <utility>
+#include <cstdint>
+#include <string_view>
+#include "../interner/interner.h"
 using namespace std;
 class symbolTable;
 
 
+const int NO_SLOT = -1;
+const int LOCAL_FRAME = 0; // depth of the frame of the function being run
+const int GLOBAL_FRAME = 1; // depth of the frame holding the global variables
+
+
+/***
+ * This is where a variable lives while the program runs, the frame it is in (counted
+ * outwards from the function being run) and its index in that frame
+ */
+struct frameSlot {
+    int depth = NO_SLOT;
+    int index = NO_SLOT;
+
+    [[nodiscard]] bool valid() const { return index != NO_SLOT; }
+};
+
+
+// what a symbol table entry names
+enum symbolKind : uint8_t {
+    SK_DATATYPE, SK_FUNCTION, SK_PROCEDURE, SK_COUNT
+};
+
+// the text of each kind in the symbol table output
+constexpr string_view SYMBOL_KIND_TITLES[SK_COUNT] = {"datatype", "function", "procedure"};
+
+// the data type of a variable or of what a function returns (DT_NONE for a procedure,
+// DT_INVALID if another name was written where the data type goes)
+enum dataKind : uint8_t {
+    DT_NONE, DT_INT, DT_CHAR, DT_BOOL, DT_INVALID, DT_COUNT
+};
+
+// the text of each data type in the symbol table output
+constexpr string_view DATA_KIND_TITLES[DT_COUNT] = {"NOT APPLICABLE", "int", "char", "bool", ""};
+
+
+/***
+ * This gets the data type a name spells
+ * @param spelling the name (empty for none)
+ * @return the data type
+ */
+constexpr dataKind dataKindOf(uint32_t spelling)
+{
+    if (spelling == 0)
+        return DT_NONE;
+    if (spelling == keywordId(KW_INT))
+        return DT_INT;
+    if (spelling == keywordId(KW_CHAR))
+        return DT_CHAR;
+    if (spelling == keywordId(KW_BOOL))
+        return DT_BOOL;
+    return DT_INVALID;
+}
+
+
 class stNode {
 
 public:
 
     // non-arrays
-    stNode(string name, string _type, string dataType, int programScope): _idName{std::move(name)},
-     _idType{std::move(_type)}, _dataType{std::move(dataType)}, _isArr{false}, _arrSize{0}, _scope{programScope},
-     _next{nullptr}, _paramList{nullptr} {}
+    stNode(internedString name, symbolKind kind, internedString dataType, int programScope):
+    stNode(name, kind, dataType, false, 0, programScope) {}
 
     // arrays
-    stNode(string name, string _type, string dataType, bool isArray, int size, int programScope):
-    _idName{std::move(name)},_idType{std::move(_type)}, _dataType{std::move(dataType)}, _isArr{isArray}, _arrSize{size},
-    _scope{programScope}, _next{nullptr}, _paramList{nullptr} {}
+    stNode(internedString name, symbolKind kind, internedString dataType, bool isArray, int size, int programScope):
+    _nameId{name.id()}, _scope{programScope}, _arrSize{size}, _kind{kind}, _dataType{dataKindOf(dataType.id())},
+    _isArr{isArray}, _invalidDataType{_dataType == DT_INVALID ? dataType.id() : 0}, _next{nullptr},
+    _paramList{nullptr} {}
 
     // functions
     void next(stNode * nextNode) { _next = nextNode; }
     void addST(symbolTable * _st) { _paramList = _st; }
+    void scope(int programScope) { _scope = programScope; }
+    void slot(frameSlot varSlot) { _slot = varSlot; }
+    void frameSize(int slots) { _frameSize = slots; }
 
     stNode * next() { return _next; }
     symbolTable * paramList() { return _paramList; }
 
-    string idName() { return _idName; }
-    string type() { return _idType; }
-    string dataType() { return _dataType; }
-
+    [[nodiscard]] string_view idName() const { return interner::global().text(_nameId); }
+    [[nodiscard]] internedString name() const { return internedString::fromId(_nameId); }
+    [[nodiscard]] symbolKind kind() const { return _kind; }
+    [[nodiscard]] dataKind dataType() const { return _dataType; }
+    [[nodiscard]] string_view type() const { return SYMBOL_KIND_TITLES[_kind]; }
+    [[nodiscard]] string_view dataTypeTitle() const
+    {
+        return _dataType == DT_INVALID ? interner::global().text(_invalidDataType) : DATA_KIND_TITLES[_dataType];
+    }
+
+    [[nodiscard]] bool isVariable() const { return _kind == SK_DATATYPE; }
     [[nodiscard]] bool isArr() const { return _isArr; }
     [[nodiscard]] int size() const { return _arrSize; }
     [[nodiscard]] int scope() const { return _scope; }
+    [[nodiscard]] frameSlot slot() const { return _slot; }
+    [[nodiscard]] int frameSize() const { return _frameSize; } // slots of a function's frame
 
 
 private:
 
-    string _idName;
-    string _idType;
-    string _dataType;
-    bool _isArr;
-    int _arrSize;
+    // the fields every lookup reads are packed together at the front
+    uint32_t _nameId;
     int _scope;
+    int _arrSize;
+    symbolKind _kind;
+    dataKind _dataType;
+    bool _isArr;
+    uint32_t _invalidDataType; // name ID of the text written as the data type if it is not one
     stNode * _next;
     symbolTable * _paramList;
+    frameSlot _slot; // assigned by the resolver (see resolver)
+    int _frameSize = 0;
 
 };
 
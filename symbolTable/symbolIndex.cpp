@@ -0,0 +1,296 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "symbolIndex.h"
+#include <unordered_set>
+using namespace std;
+
+
+/***
+ * This spreads the bits of a key over the whole word (the names' IDs are small and
+ * sequential, and so are the scopes)
+ * @param key the key
+ * @return the hash
+ */
+static inline uint64_t hashKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+}
+
+
+/***
+ * This checks if a node can be found by a lookup from the given scope
+ * @param entry the node's entry
+ * @param scope scope of the lookup
+ * @return true if its table is searched from the scope
+ */
+bool symbolIndex::seenFrom(const symbolEntry& entry, int scope)
+{
+    return entry.visibleScope == VISIBLE_IN_ANY_SCOPE || entry.visibleScope == scope;
+}
+
+
+/***
+ * This finds the slot of a key
+ * @param key the key
+ * @return the slot (the empty slot the key would go in if it is not there)
+ */
+size_t symbolIndex::find(uint64_t key) const
+{
+    size_t mask = slots.size() - 1;
+    size_t idx = hashKey(key) & mask;
+    while (slots[idx].occupied && slots[idx].key != key)
+        idx = (idx + 1) & mask;
+    return idx;
+}
+
+
+/***
+ * This finds the slot of a key, adding the key if it is not there yet
+ * @param key the key
+ * @return the slot
+ */
+size_t symbolIndex::claim(uint64_t key)
+{
+    // keys are never taken back out, so the table is only kept at most half full
+    if ((used + 1) * 2 > slots.size())
+        grow();
+    size_t idx = find(key);
+    if (!slots[idx].occupied)
+    {
+        slots[idx].occupied = true;
+        slots[idx].key = key;
+        used++;
+    }
+    return idx;
+}
+
+
+/***
+ * This doubles the number of slots and puts every key back in
+ */
+void symbolIndex::grow()
+{
+    vector<slot> old = std::move(slots);
+    slots.assign(old.size() * 2, slot());
+    for (const slot& cur : old)
+    {
+        if (cur.occupied)
+            slots[find(cur.key)] = cur;
+    }
+}
+
+
+/***
+ * This adds an entry for a node under a key, after the entries already under it
+ * @param node the node
+ * @param rank the node's place in the tables
+ * @param key the key
+ * @param visibleScope scope the node's table is searched from
+ */
+void symbolIndex::link(stNode * node, uint64_t rank, uint64_t key, int visibleScope)
+{
+    auto entryIdx = (uint32_t) entries.size();
+    slot& cur = slots[claim(key)];
+    entries.push_back({node, rank, key, visibleScope, cur.last, NO_SYMBOL_ENTRY});
+    if (cur.last == NO_SYMBOL_ENTRY)
+        cur.first = entryIdx;
+    else
+        entries[cur.last].next = entryIdx;
+    cur.last = entryIdx;
+}
+
+
+/***
+ * This adds a node after every node already in the index. A node of the main list comes
+ * before the nodes of every parameter list, and a parameter list's nodes are added after
+ * startParamList is called for it
+ * @param node the node
+ * @param inParamList true if the node is in a parameter list
+ * @param visibleScope scope the node's table is searched from (VISIBLE_IN_ANY_SCOPE for
+ * the main list)
+ */
+void symbolIndex::add(stNode * node, bool inParamList, int visibleScope)
+{
+    uint64_t rank = inParamList ? tableNum << 32 | paramNum++ : mainNum++;
+    link(node, rank, keyOf(node->name(), node->scope()), visibleScope);
+    // functions are found by name from every scope (see symbolTable::retrieveNode)
+    if (node->kind() == SK_FUNCTION)
+        link(node, rank, keyOf(node->name(), FUNCTION_KEY_SCOPE), visibleScope);
+    else if (node->kind() == SK_PROCEDURE)
+        procedures++;
+
+    if (node->scope() == 0)
+    {
+        if (visibleScope == VISIBLE_IN_ANY_SCOPE)
+            anyScopeGlobals++;
+        else
+            scopeGlobals[visibleScope]++;
+    }
+}
+
+
+/***
+ * This takes out the nodes added last, they have to be the given nodes (in any order)
+ * @param nodes the nodes
+ * @return false if the newest entries are not the given nodes (the index is left
+ * partly emptied and can not be used)
+ */
+bool symbolIndex::removeNewest(const vector<stNode *>& nodes)
+{
+    unordered_set<stNode *> remaining(nodes.begin(), nodes.end());
+    while (!remaining.empty() && !entries.empty())
+    {
+        const symbolEntry& entry = entries.back();
+        if (!remaining.count(entry.node))
+            return false;
+
+        // the newest entry is the last one under its key
+        slot& cur = slots[find(entry.key)];
+        cur.last = entry.prev;
+        if (entry.prev == NO_SYMBOL_ENTRY)
+            cur.first = NO_SYMBOL_ENTRY;
+        else
+            entries[entry.prev].next = NO_SYMBOL_ENTRY;
+
+        // a function's first entry is under its own scope
+        if ((uint32_t) entry.key != FUNCTION_KEY_SCOPE || entry.node->kind() != SK_FUNCTION)
+        {
+            if (entry.node->kind() == SK_PROCEDURE)
+                procedures--;
+            if (entry.node->scope() == 0)
+            {
+                if (entry.visibleScope == VISIBLE_IN_ANY_SCOPE)
+                    anyScopeGlobals--;
+                else
+                    scopeGlobals[entry.visibleScope]--;
+            }
+            remaining.erase(entry.node);
+        }
+        entries.pop_back();
+    }
+    return remaining.empty();
+}
+
+
+/***
+ * This picks the earlier of the current match and the first match under a key
+ * @param key the key
+ * @param scope scope of the lookup
+ * @param current the match so far (null if none)
+ * @param checkArr true if the node has to be an array exactly when isArr is
+ * @param isArr whether the node has to be an array
+ * @return the earlier match
+ */
+const symbolEntry * symbolIndex::best(uint64_t key, int scope, const symbolEntry * current,
+                                      bool checkArr, bool isArr) const
+{
+    const slot& cur = slots[find(key)];
+    if (!cur.occupied)
+        return current;
+    for (uint32_t idx = cur.first; idx != NO_SYMBOL_ENTRY; idx = entries[idx].next)
+    {
+        const symbolEntry& entry = entries[idx];
+        if (current && current->rank <= entry.rank)
+            continue;
+        if (seenFrom(entry, scope) && (!checkArr || entry.node->isArr() == isArr))
+            current = &entry;
+    }
+    return current;
+}
+
+
+/***
+ * This finds the first node with a name that is either in the given scope or global
+ * and is an array exactly when asked for (see symbolTable::inUse)
+ * @param name the name
+ * @param scope the scope
+ * @param isArr whether the node has to be an array
+ * @return the node (null if there is none)
+ */
+stNode * symbolIndex::firstInUse(internedString name, int scope, bool isArr) const
+{
+    const symbolEntry * found = best(keyOf(name, scope), scope, nullptr, true, isArr);
+    if (scope != 0)
+        found = best(keyOf(name, 0), scope, found, true, isArr);
+    return found ? found->node : nullptr;
+}
+
+
+/***
+ * This finds the first node with a name that is either in the given scope or a
+ * function (see symbolTable::retrieveNode)
+ * @param name the name
+ * @param scope the scope
+ * @return the node (null if there is none)
+ */
+stNode * symbolIndex::firstVariableOrFunction(internedString name, int scope) const
+{
+    const symbolEntry * found = best(keyOf(name, scope), scope, nullptr, false, false);
+    found = best(keyOf(name, FUNCTION_KEY_SCOPE), scope, found, false, false);
+    return found ? found->node : nullptr;
+}
+
+
+/***
+ * This finds the first variable (not a function or procedure) with a name in the given
+ * scope (see symbolTable::retrieveVariable)
+ * @param name the name
+ * @param scope the scope
+ * @return the node (null if there is none)
+ */
+stNode * symbolIndex::firstVariable(internedString name, int scope) const
+{
+    const slot& cur = slots[find(keyOf(name, scope))];
+    const symbolEntry * found = nullptr;
+    for (uint32_t idx = cur.occupied ? cur.first : NO_SYMBOL_ENTRY; idx != NO_SYMBOL_ENTRY; idx = entries[idx].next)
+    {
+        const symbolEntry& entry = entries[idx];
+        if ((!found || entry.rank < found->rank) && seenFrom(entry, scope) && entry.node->isVariable())
+            found = &entry;
+    }
+    return found ? found->node : nullptr;
+}
+
+
+/***
+ * This finds the first function with a name, functions are only in the main list so
+ * they can be found from any scope (see symbolTable::addParamList)
+ * @param name the name
+ * @return the node (null if there is none)
+ */
+stNode * symbolIndex::firstFunction(internedString name) const
+{
+    const symbolEntry * found = best(keyOf(name, FUNCTION_KEY_SCOPE), VISIBLE_IN_ANY_SCOPE, nullptr, false, false);
+    return found ? found->node : nullptr;
+}
+
+
+/***
+ * This checks if any global node can be found from a scope
+ * @param scope the scope
+ * @return true if one can
+ */
+bool symbolIndex::anyGlobalVisible(int scope) const
+{
+    if (anyScopeGlobals)
+        return true;
+    auto globals = scopeGlobals.find(scope);
+    return globals != scopeGlobals.end() && globals->second;
+}
+
+
+/***
+ * This checks if a node with a name in a scope can be found from that scope
+ * @param name the name
+ * @param scope the scope
+ * @return true if one can
+ */
+bool symbolIndex::visible(internedString name, int scope) const
+{
+    return best(keyOf(name, scope), scope, nullptr, false, false) != nullptr;
+}
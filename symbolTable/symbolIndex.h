@@ -0,0 +1,87 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_SYMBOLINDEX_H
+#define ASSIGNMENT5_SYMBOLINDEX_H
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "stNode.h"
+using namespace std;
+
+
+const uint32_t NO_SYMBOL_ENTRY = UINT32_MAX;
+const int VISIBLE_IN_ANY_SCOPE = -1; // the entry's table is searched from every scope
+const uint32_t FUNCTION_KEY_SCOPE = UINT32_MAX; // function nodes are also kept under this scope
+const size_t SYMBOL_INDEX_MIN_SLOTS = 64;
+
+
+/***
+ * This is one node of a symbol table in the index. The rank is the node's place in the
+ * order the linear lookups used to walk the tables in (the main list first, then each
+ * parameter list), so the first of several matches is the one with the lowest rank
+ */
+struct symbolEntry {
+    stNode * node;
+    uint64_t rank; // number of the node's table (0 for the main list) and of the node in it
+    uint64_t key; // name ID and scope
+    int visibleScope; // scope the node's table is searched from (see VISIBLE_IN_ANY_SCOPE)
+    uint32_t prev, next; // entries with the same key, oldest first
+};
+
+
+/***
+ * This is a hash table over the nodes of a chain of symbol tables, keyed by interned
+ * name and scope (open addressing with linear probing). Each key holds the nodes with
+ * that name in that scope, and a node's table decides which scopes it can be seen from
+ * (a parameter list is only searched from its function's scope). Nodes are added in the
+ * order they are linked into the tables and the newest ones can be taken out again
+ */
+class symbolIndex {
+
+public:
+    symbolIndex() { slots.resize(SYMBOL_INDEX_MIN_SLOTS); }
+
+    void add(stNode * node, bool inParamList, int visibleScope);
+    void startParamList() { tableNum++; paramNum = 0; }
+    bool removeNewest(const vector<stNode *>& nodes);
+
+    [[nodiscard]] stNode * firstInUse(internedString name, int scope, bool isArr) const;
+    [[nodiscard]] stNode * firstVariableOrFunction(internedString name, int scope) const;
+    [[nodiscard]] stNode * firstVariable(internedString name, int scope) const;
+    [[nodiscard]] stNode * firstFunction(internedString name) const;
+    [[nodiscard]] bool anyProcedure() const { return procedures; }
+    [[nodiscard]] bool anyGlobalVisible(int scope) const;
+    [[nodiscard]] bool visible(internedString name, int scope) const;
+
+private:
+    struct slot {
+        uint64_t key = 0;
+        uint32_t first = NO_SYMBOL_ENTRY, last = NO_SYMBOL_ENTRY;
+        bool occupied = false;
+    };
+
+    static uint64_t keyOf(internedString name, uint32_t scope) { return (uint64_t) name.id() << 32 | scope; }
+    static bool seenFrom(const symbolEntry& entry, int scope);
+    size_t find(uint64_t key) const;
+    size_t claim(uint64_t key);
+    void grow();
+    void link(stNode * node, uint64_t rank, uint64_t key, int visibleScope);
+    [[nodiscard]] const symbolEntry * best(uint64_t key, int scope, const symbolEntry * current,
+                                           bool checkArr, bool isArr) const;
+
+    vector<slot> slots; // the number of slots is a power of two
+    size_t used = 0;
+    vector<symbolEntry> entries;
+    uint64_t mainNum = 0; // rank of the next node of the main list
+    uint64_t tableNum = 0, paramNum = 0; // rank of the next node of the last parameter list
+    size_t anyScopeGlobals = 0; // global nodes searched from every scope
+    size_t procedures = 0;
+    unordered_map<int, size_t> scopeGlobals; // global nodes in parameter lists, by the scope they are seen from
+
+};
+
+
+#endif //ASSIGNMENT5_SYMBOLINDEX_H
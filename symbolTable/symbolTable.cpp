@@ -13,6 +13,20 @@
  * @param ST the symbol table to be inserted
  */
 void symbolTable::insertST(symbolTable * ST)
+{
+    appendST(ST);
+    // add to its function node
+    addParamList(ST);
+}
+
+
+/***
+ * This links a parameter list symbol table to the end of the list without adding it to
+ * its function node (a table that is only part of the program does not know which
+ * function node the whole program will add it to, see append)
+ * @param ST the symbol table to be linked
+ */
+void symbolTable::appendST(symbolTable * ST)
 {
     if (!_next)
     {
@@ -23,51 +37,172 @@ void symbolTable::insertST(symbolTable * ST)
         _tail->_next = ST;
         _tail = ST;
     }
-    // add to its function node
-    addParamList(ST);
+    if (index)
+        indexParamList(ST);
 }
 
 
 /***
- * This adds a parameter list pointer to its function symbol table
- * counterpart
- * @param PL the symbol table to be added
+ * This moves the nodes and parameter lists of a symbol table built for a later part of
+ * the program to the end of this one, the parameter lists are added to their function
+ * nodes as if they were inserted here. The other table is left empty
+ * @param other the symbol table to be moved
  */
-void symbolTable::addParamList(symbolTable * PL)
+void symbolTable::append(symbolTable * other)
 {
-    if (_head)
+    if (other->_head)
     {
-        stNode * iter = _head;
-        while (iter)
+        if (!_head)
+            _head = other->_head;
+        else
+            curNode->next(other->_head);
+        curNode = other->curNode;
+        for (stNode * iter = other->_head; index && iter; iter = iter->next())
+            index->add(iter, false, visibleScope());
+    }
+    other->index = nullptr;
+
+    symbolTable * PL = other->_next;
+    while (PL)
+    {
+        symbolTable * nextPL = PL->_next;
+        PL->_next = nullptr;
+        insertST(PL);
+        PL = nextPL;
+    }
+    other->_head = other->curNode = nullptr;
+    other->_next = other->_tail = nullptr;
+}
+
+
+/***
+ * This links the nodes and parameter lists of another symbol table after this one's
+ * without moving them, the other table still owns them (a session's table for the whole
+ * program is linked together from the tables of its pieces, see session). The lists end
+ * with the other table's, whatever its last node and list were linked to before
+ * @param other the symbol table to be linked
+ */
+void symbolTable::link(symbolTable * other)
+{
+    if (other->_head)
+    {
+        if (!_head)
+            _head = other->_head;
+        else
+            curNode->next(other->_head);
+        curNode = other->curNode;
+        curNode->next(nullptr);
+        for (stNode * iter = other->_head; index && iter; iter = iter->next())
+            index->add(iter, false, visibleScope());
+    }
+    if (other->_next)
+    {
+        if (!_next)
+            _next = other->_next;
+        else
+            _tail->_next = other->_next;
+        _tail = other->_tail;
+        _tail->_next = nullptr;
+        for (symbolTable * PL = other->_next; index && PL; PL = PL->_next)
+            indexParamList(PL);
+    }
+}
+
+
+/***
+ * This moves the nodes and parameter lists inserted into another symbol table after the
+ * given ones to this (empty) table, the other table is left ending at the given ones
+ * @param other the symbol table the nodes were inserted into
+ * @param last the last node to leave in the other table (null to move all of them)
+ * @param lastPL the last parameter list to leave in the other table (null to move all of them)
+ */
+void symbolTable::adopt(symbolTable * other, stNode * last, symbolTable * lastPL)
+{
+    _head = last ? last->next() : other->_head;
+    curNode = _head ? other->curNode : nullptr;
+    _next = lastPL ? lastPL->_next : other->_next;
+    _tail = _next ? other->_tail : nullptr;
+
+    if (last)
+        last->next(nullptr);
+    else
+        other->_head = nullptr;
+    other->curNode = last;
+    if (lastPL)
+        lastPL->_next = nullptr;
+    else
+        other->_next = nullptr;
+    other->_tail = lastPL;
+
+    // the nodes moved here were the last ones added to the other table's index
+    if (other->index)
+    {
+        vector<stNode *> moved;
+        for (symbolTable * tableIter = this; tableIter; tableIter = tableIter->_next)
         {
-            if (iter->type() == "function")
-            {
-                if (iter->idName() == PL->_name)
-                {
-                    iter->addST(PL);
-                    return;
-                }
-            }
-            iter = iter->next();
+            for (stNode * iter = tableIter->_head; iter; iter = iter->next())
+                moved.push_back(iter);
         }
+        if (!other->index->removeNewest(moved))
+            other->index = nullptr;
     }
 }
 
 
+/***
+ * This empties a symbol table that only links other tables' nodes without deleting them
+ * (see link)
+ */
+void symbolTable::release()
+{
+    _head = curNode = nullptr;
+    _next = _tail = nullptr;
+    index = nullptr;
+}
+
+
+/***
+ * This changes the scope of every node (and parameter) that is not global by the same
+ * amount, it is used when functions are added or removed before the ones in the table
+ * @param delta amount the scopes change by
+ */
+void symbolTable::shiftScopes(int delta)
+{
+    for (symbolTable * tableIter = this; tableIter; tableIter = tableIter == _tail ? nullptr : tableIter->_next)
+    {
+        for (stNode * iter = tableIter->_head; iter; iter = iter == tableIter->curNode ? nullptr : iter->next())
+        {
+            if (iter->scope() != 0)
+                iter->scope(iter->scope() + delta);
+        }
+        tableIter->index = nullptr;
+    }
+}
+
+
+/***
+ * This adds a parameter list pointer to its function symbol table
+ * counterpart
+ * @param PL the symbol table to be added
+ */
+void symbolTable::addParamList(symbolTable * PL)
+{
+    // the first function with the list's name (a procedure's list is not added)
+    stNode * function = indexed().firstFunction(PL->_name);
+    if (function)
+        function->addST(PL);
+}
+
+
 /***
  * This function checks if a program has a main function/procedure
  * @return true if there is a main, false if not
  */
 bool symbolTable::programHasMain()
 {
-    stNode * iter = _head;
-    while (iter)
-    {
-        if (iter->idName() == "main" && (iter->type() == "function") || (iter->type() == "procedure"))
-            return true;
-        iter = iter->next();
-    }
-    return false;
+    // any procedure counts, whatever its name (the name check only ever covered functions)
+    symbolIndex& found = indexed();
+    return found.anyProcedure() || found.firstFunction(internedString::fromId(keywordId(KW_MAIN)));
 }
 
 
@@ -87,6 +222,8 @@ void symbolTable::insert(stNode *& node)
             curNode = curNode->next();
 
         }
+        if (index)
+            index->add(node, false, visibleScope());
         node = nullptr;
     }
 }
@@ -100,28 +237,12 @@ void symbolTable::insert(stNode *& node)
  */
 bool symbolTable::inUse(stNode * node, int& foundScope)
 {
-    symbolTable * tableIter = this;
-    stNode * iter;
-    while(tableIter)
-    {
-        iter = tableIter->_head;
-        // this ensures you are either looking through the main list of variables or
-        // the parameter list of the function with the same scope
-        if (tableIter->_name.empty() || tableIter->head()->scope() == node->scope()) {
-            while (iter) {
-                // if the var shares the same name and is in the same scope (or global)
-                if (iter->idName() == node->idName() && iter->isArr() == node->isArr() &&
-                    (iter->scope() == node->scope() || iter->scope() == 0)) {
-                    foundScope = iter->scope(); // used for debug messages
-                    return true;
-                }
-                iter = iter->next();
-
-            }
-        }
-        tableIter = tableIter->_next;
-    }
-    return false;
+    // the first node in the main list or the parameter list of the function with the
+    // same scope that shares the name and is in the same scope (or global)
+    stNode * found = indexed().firstInUse(node->name(), node->scope(), node->isArr());
+    if (found)
+        foundScope = found->scope(); // used for debug messages
+    return found;
 }
 
 
@@ -158,7 +279,7 @@ void symbolTable::output(const string& outputFile)
             outFS << "      IDENTIFIER_NAME: " << iter->idName() << endl;
             if (!paramList)
                 outFS << "      IDENTIFIER_TYPE: " << iter->type() << endl;
-            outFS << "             DATATYPE: " << iter->dataType() << endl;
+            outFS << "             DATATYPE: " << iter->dataTypeTitle() << endl;
             outFS << "    DATATYPE_IS_ARRAY: ";
             if (iter->isArr())
                 outFS << "yes\n";
@@ -186,7 +307,8 @@ symbolTable::~symbolTable()
 
 /***
  * This function iterates through an assortment of symbol tables (and their LL)
- * to delete all the nodes and STs
+ * to delete all the nodes and STs. It stops at the last node and list of the
+ * table, anything linked after them belongs to another table (see link)
  */
 void symbolTable::deleteNodes()
 {
@@ -198,14 +320,19 @@ void symbolTable::deleteNodes()
         while (iter)
         {
             temp = iter;
-            iter = iter->next();
+            iter = iter == tableIter->curNode ? nullptr : iter->next();
             delete temp;
         }
+        tableIter->_head = tableIter->curNode = nullptr;
         tempTable = tableIter;
-        tableIter = tableIter->_next;
-        delete tempTable;
+        tableIter = tableIter == _tail ? nullptr : tableIter->_next;
+        // the parameter lists are emptied first so their own destructors have nothing to do
+        tempTable->_next = nullptr;
+        if (tempTable != this)
+            delete tempTable;
     }
-    _head = nullptr;
+    _tail = nullptr;
+    index = nullptr;
 }
 
 
@@ -215,25 +342,9 @@ void symbolTable::deleteNodes()
  * @param scope scope of the variable
  * @return pointer to the STnode if it exists
  */
-stNode * symbolTable::retrieveNode(const string& name, const int& scope)
+stNode * symbolTable::retrieveNode(internedString name, const int& scope)
 {
-    symbolTable * tableIter = this;
-    stNode * iter;
-    while(tableIter)
-    {
-        iter = tableIter->_head;
-        if (tableIter->_name.empty() || tableIter->head()->scope() == scope) {
-            while (iter) {
-                if (iter->idName() == name && (iter->scope() == scope || iter->type() == "function")) {
-                    return iter;
-                }
-                iter = iter->next();
-
-            }
-        }
-        tableIter = tableIter->_next;
-    }
-    return nullptr;
+    return indexed().firstVariableOrFunction(name, scope);
 }
 
 
@@ -244,24 +355,70 @@ stNode * symbolTable::retrieveNode(const string& name, const int& scope)
  * @param scope scope of the variable
  * @return pointer to the STnode if it exists
  */
-bool symbolTable::exists(const string& name, const int& scope)
+bool symbolTable::exists(internedString name, const int& scope)
 {
-    symbolTable * tableIter = this;
-    stNode * iter;
-    while(tableIter)
+    // any global found counts, whatever its name (the name check never covered it)
+    symbolIndex& found = indexed();
+    return found.anyGlobalVisible(scope) || found.visible(name, scope);
+}
+
+
+/***
+ * This finds the variable a name used in a scope refers to, a local variable or
+ * parameter of that scope hides a global one
+ * @param name name of the variable
+ * @param scope scope the name is used in
+ * @return pointer to the STnode (null if no variable is visible)
+ */
+stNode * symbolTable::retrieveVariable(internedString name, int scope)
+{
+    stNode * found = indexed().firstVariable(name, scope);
+    if (!found && scope != 0)
+        found = indexed().firstVariable(name, 0);
+    return found;
+}
+
+
+/***
+ * This gets the index of the table, making it from the nodes linked so far if the table
+ * was not searched before
+ * @return the index
+ */
+symbolIndex& symbolTable::indexed()
+{
+    if (!index)
     {
-        iter = tableIter->_head;
-        if (tableIter->_name.empty() || tableIter->head()->scope() == scope) {
-            while (iter) {
-                if (iter->idName() == name && (iter->scope() == scope) || (iter->scope() == 0)) {
-                    return true;
-                }
-                iter = iter->next();
-
-            }
-        }
-        tableIter = tableIter->_next;
+        index = make_unique<symbolIndex>();
+        for (stNode * iter = _head; iter; iter = iter->next())
+            index->add(iter, false, visibleScope());
+        for (symbolTable * PL = _next; PL; PL = PL->_next)
+            indexParamList(PL);
     }
-    return false;
+    return *index;
+}
+
+
+/***
+ * This adds the nodes of a parameter list linked after the others to the index
+ * @param PL the parameter list
+ */
+void symbolTable::indexParamList(symbolTable * PL)
+{
+    index->startParamList();
+    for (stNode * iter = PL->_head; iter; iter = iter->next())
+        index->add(iter, true, PL->visibleScope());
+}
+
+
+/***
+ * This gets the scope a table is searched from, the main list is searched from every
+ * scope and a parameter list only from its function's scope (the scope of its first node)
+ * @return the scope
+ */
+int symbolTable::visibleScope() const
+{
+    if (_name.empty() || !_head)
+        return VISIBLE_IN_ANY_SCOPE;
+    return _head->scope();
 }
 
@@ -7,39 +7,60 @@
 #include <utility>
 
 #include "stNode.h"
+#include "symbolIndex.h"
+#include <memory>
 #include "../tokenize/tokenList.h"
 #include "../tokenize/tokenize.h"
 
 
+/***
+ * This is the list of nodes of a scope chain, the main list comes first and the
+ * parameter lists follow it. The lookups are answered from an index over the chain
+ * that is made the first time it is searched and kept up to date as nodes are linked in
+ */
 class symbolTable {
 
 public:
     symbolTable(): _head{nullptr}, curNode{nullptr}, _next{nullptr}, _tail{nullptr} {}
-    explicit symbolTable(string name): _name{std::move(name)}, _head{nullptr}, curNode{nullptr}, _next{nullptr},
+    explicit symbolTable(internedString name): _name{name}, _head{nullptr}, curNode{nullptr}, _next{nullptr},
     _tail{nullptr} {}
     ~symbolTable();
 
     void insert( stNode *& _token);
     void insertST(symbolTable * ST);
+    void appendST(symbolTable * ST);
+    void append(symbolTable * other);
+    void link(symbolTable * other);
+    void adopt(symbolTable * other, stNode * last, symbolTable * lastPL);
+    void release();
+    void shiftScopes(int delta);
     void output(const string& outputFile);
     void deleteNodes();
     void addParamList(symbolTable * PL);
     void next(symbolTable * ST) { _next = ST; }
 
     bool inUse(stNode * node, int& foundScope);
-    bool exists(const string& name, const int& scope);
+    bool exists(internedString name, const int& scope);
     bool programHasMain();
 
     stNode * head() { return _head; }
-    stNode * retrieveNode(const string& name, const int& scope);
+    stNode * last() { return curNode; }
+    internedString name() const { return _name; }
+    stNode * retrieveNode(internedString name, const int& scope);
+    stNode * retrieveVariable(internedString name, int scope);
 
     symbolTable * next() { return _next; }
     symbolTable * tail() { return _tail; }
 
 private:
+    symbolIndex& indexed();
+    void indexParamList(symbolTable * PL);
+    [[nodiscard]] int visibleScope() const;
+
     stNode * _head, * curNode;
-    string _name;
+    internedString _name; // name of the function if this is a parameter list
     symbolTable * _next, * _tail;
+    unique_ptr<symbolIndex> index; // null until the table is searched
 
 };
 
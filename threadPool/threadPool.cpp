@@ -0,0 +1,168 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "threadPool.h"
+using namespace std;
+
+
+// the pool and queue of the worker thread running this (outside threads use the last queue)
+static thread_local const threadPool * currentPool = nullptr;
+static thread_local unsigned int currentQueue = 0;
+
+
+/***
+ * This starts the worker threads
+ * @param threads the number of threads that run tasks, counting the thread that calls
+ * run (0 uses one per core)
+ */
+threadPool::threadPool(unsigned int threads)
+{
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+
+    queueCount = threads;
+    queues = make_unique<taskQueue[]>(queueCount);
+    for (unsigned int idx = 1; idx < threads; idx++)
+        workers.emplace_back([this, idx] { work(idx - 1); });
+}
+
+
+/***
+ * This stops the worker threads once the queued tasks are done
+ */
+threadPool::~threadPool()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers)
+        worker.join();
+}
+
+
+/***
+ * This runs task(0) to task(count - 1) on the pool and waits for all of them to finish
+ * @param count the number of tasks
+ * @param task the task, it is given its index
+ * @param alongside work the calling thread does while the tasks run (it starts before
+ * the calling thread helps with them, so it is never stuck behind one)
+ */
+void threadPool::run(size_t count, const function<void(size_t)>& task, const function<void()>& alongside)
+{
+    if (count == 0)
+        return;
+
+    atomic<size_t> remaining{count};
+    unsigned int home = homeQueue();
+    // deal the tasks out to every queue, starting with this thread's own
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        taskQueue& target = queues[(home + idx) % queueCount];
+        lock_guard<mutex> guard(target.lock);
+        target.tasks.emplace_back([this, &task, &remaining, idx]
+        {
+            task(idx);
+            if (--remaining == 0)
+            {
+                lock_guard<mutex> doneGuard(lock);
+                wake.notify_all();
+            }
+        });
+        queued++;
+    }
+    {
+        lock_guard<mutex> guard(lock);
+    }
+    wake.notify_all();
+
+    if (alongside)
+        alongside();
+
+    // help with the queued tasks until every task of this run is done
+    while (remaining > 0)
+    {
+        if (runOne(home))
+            continue;
+        unique_lock<mutex> guard(lock);
+        wake.wait(guard, [this, &remaining] { return remaining == 0 || queued > 0; });
+    }
+}
+
+
+/***
+ * This runs one queued task, the thread's own newest task or else the oldest task of
+ * another thread
+ * @param home the queue of the thread
+ * @return true if a task was run, false if every queue was empty
+ */
+bool threadPool::runOne(unsigned int home)
+{
+    function<void()> job;
+    for (unsigned int step = 0; step < queueCount && !job; step++)
+    {
+        taskQueue& source = queues[(home + step) % queueCount];
+        lock_guard<mutex> guard(source.lock);
+        if (source.tasks.empty())
+            continue;
+        if (step == 0)
+        {
+            job = move(source.tasks.back());
+            source.tasks.pop_back();
+        }
+        else
+        {
+            job = move(source.tasks.front());
+            source.tasks.pop_front();
+        }
+    }
+    if (!job)
+        return false;
+
+    queued--;
+    job();
+    return true;
+}
+
+
+/***
+ * This is the loop each worker thread runs
+ * @param home the queue of the worker
+ */
+void threadPool::work(unsigned int home)
+{
+    currentPool = this;
+    currentQueue = home;
+    while (true)
+    {
+        if (runOne(home))
+            continue;
+        unique_lock<mutex> guard(lock);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0)
+            return;
+    }
+}
+
+
+/***
+ * This gets the queue of the calling thread
+ * @return the queue index
+ */
+unsigned int threadPool::homeQueue() const
+{
+    return currentPool == this ? currentQueue : queueCount - 1;
+}
+
+
+/***
+ * This gets the pool shared by the whole front end (one thread per core)
+ * @return the pool
+ */
+threadPool& threadPool::shared()
+{
+    static threadPool pool;
+    return pool;
+}
@@ -0,0 +1,60 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_THREADPOOL_H
+#define ASSIGNMENT5_THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+
+/***
+ * This is a fixed set of worker threads that the front end stages share, a stage hands
+ * it a number of independent tasks and waits for all of them (the waiting thread runs
+ * tasks too, so a task may start more tasks without deadlocking). Every thread has its
+ * own queue of tasks, a run deals its tasks out to all of them and a thread that runs
+ * out of tasks steals from the front of another queue, so tasks of very different
+ * lengths still keep every thread busy
+ */
+class threadPool {
+
+public:
+    explicit threadPool(unsigned int threads = 0);
+    ~threadPool();
+
+    void run(size_t count, const function<void(size_t)>& task, const function<void()>& alongside = nullptr);
+    [[nodiscard]] unsigned int size() const { return (unsigned int) workers.size() + 1; }
+
+    static threadPool& shared();
+
+private:
+    // tasks queued for one thread (the last queue is for threads outside the pool)
+    struct taskQueue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    void work(unsigned int home);
+    bool runOne(unsigned int home);
+    unsigned int homeQueue() const;
+
+    vector<thread> workers;
+    unique_ptr<taskQueue[]> queues;
+    unsigned int queueCount;
+    atomic<size_t> queued{0}; // tasks waiting in any of the queues
+    mutex lock;
+    condition_variable wake; // signalled when tasks are queued, a run finishes or the pool stops
+    bool stopping = false;
+
+};
+
+
+#endif //ASSIGNMENT5_THREADPOOL_H
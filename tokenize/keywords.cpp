@@ -0,0 +1,214 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "keywords.h"
+#include <algorithm>
+#include <iterator>
+using namespace std;
+
+
+// The keyword table is a perfect hash built at compile time: the first hash picks a
+// bucket, every bucket has a displacement that was chosen so that the second hash of
+// each word lands in its own slot, so a lookup is always a single string compare
+
+const int KEYWORD_BUCKETS = 64;
+const int KEYWORD_SLOTS = 256;
+const int MAX_KEYWORDS = size(POSSIBLE_TOKENS) + size(VAR_RESERVED_WORDS) + size(FUNCTION_SPECIFIC_RESERVES) +
+                         size(POSSIBLE_RETURN_TYPES) + KW_COUNT;
+
+
+struct keywordTable {
+    keywordEntry slots[KEYWORD_SLOTS];
+    uint16_t displace[KEYWORD_BUCKETS];
+    bool perfect;
+};
+
+
+/***
+ * This hashes a word (FNV-1a mixed with a seed)
+ * @param text the word
+ * @param seed the seed (0 for the bucket hash, the displacement for the slot hash)
+ * @return the hash
+ */
+constexpr uint32_t keywordHash(string_view text, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (char c : text)
+    {
+        hash ^= (unsigned char) c;
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+
+/***
+ * This adds a word to the list of entries, or merges it with the entry that already
+ * holds the same word
+ * @param entries the entries collected so far
+ * @param count the number of entries
+ * @param text the word
+ * @param kind the special token it is
+ * @param word the grammar keyword it is
+ * @param flags the lists it is in
+ */
+constexpr void addWord(keywordEntry * entries, int& count, string_view text, tokenKind kind, keywordKind word,
+                       uint8_t flags)
+{
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (entries[idx].text == text)
+        {
+            if (kind != TK_UNKNOWN)
+                entries[idx].kind = kind;
+            if (word != KW_NONE)
+                entries[idx].word = word;
+            entries[idx].flags |= flags;
+            return;
+        }
+    }
+    entries[count++] = {text, kind, word, flags};
+}
+
+
+/***
+ * This builds the keyword table from the word lists
+ * @return the table (perfect is false if no displacement worked for some bucket)
+ */
+constexpr keywordTable buildKeywordTable()
+{
+    keywordTable table{};
+    keywordEntry entries[MAX_KEYWORDS]{};
+    int count = 0;
+
+    for (size_t idx = 0; idx < size(POSSIBLE_TOKENS); idx++)
+        addWord(entries, count, POSSIBLE_TOKENS[idx], (tokenKind) (TK_L_PAREN + idx), KW_NONE, 0);
+    for (string_view text : VAR_RESERVED_WORDS)
+        addWord(entries, count, text, TK_UNKNOWN, KW_NONE, KF_VAR_RESERVED);
+    for (string_view text : FUNCTION_SPECIFIC_RESERVES)
+        addWord(entries, count, text, TK_UNKNOWN, KW_NONE, KF_FUNCTION_RESERVED);
+    for (string_view text : POSSIBLE_RETURN_TYPES)
+        addWord(entries, count, text, TK_UNKNOWN, KW_NONE, KF_RETURN_TYPE);
+    for (int word = KW_NONE + 1; word < KW_COUNT; word++)
+        addWord(entries, count, KEYWORD_TITLES[word], TK_UNKNOWN, (keywordKind) word, 0);
+
+    int bucketOf[MAX_KEYWORDS]{}, bucketSizes[KEYWORD_BUCKETS]{}, largest = 0;
+    for (int idx = 0; idx < count; idx++)
+    {
+        bucketOf[idx] = (int) (keywordHash(entries[idx].text, 0) % KEYWORD_BUCKETS);
+        largest = max(largest, ++bucketSizes[bucketOf[idx]]);
+    }
+
+    // place the fullest buckets first since they are the hardest to fit
+    bool placed[MAX_KEYWORDS]{};
+    bool used[KEYWORD_SLOTS]{};
+    for (int bucketSize = largest; bucketSize > 0; bucketSize--)
+    {
+        for (int bucket = 0; bucket < KEYWORD_BUCKETS; bucket++)
+        {
+            if (bucketSizes[bucket] != bucketSize)
+                continue;
+
+            int members[MAX_KEYWORDS]{}, memberCount = 0;
+            for (int idx = 0; idx < count; idx++)
+            {
+                if (bucketOf[idx] == bucket)
+                    members[memberCount++] = idx;
+            }
+
+            // find a displacement that puts every word of the bucket in a free slot
+            bool fits = false;
+            for (uint32_t displace = 1; displace < 65536 && !fits; displace++)
+            {
+                int slots[MAX_KEYWORDS]{};
+                fits = true;
+                for (int member = 0; member < memberCount && fits; member++)
+                {
+                    slots[member] = (int) (keywordHash(entries[members[member]].text, displace) % KEYWORD_SLOTS);
+                    fits = !used[slots[member]];
+                    for (int other = 0; other < member && fits; other++)
+                        fits = slots[other] != slots[member];
+                }
+                if (!fits)
+                    continue;
+
+                table.displace[bucket] = displace;
+                for (int member = 0; member < memberCount; member++)
+                {
+                    used[slots[member]] = true;
+                    table.slots[slots[member]] = entries[members[member]];
+                    placed[members[member]] = true;
+                }
+            }
+        }
+    }
+
+    table.perfect = true;
+    for (int idx = 0; idx < count; idx++)
+        table.perfect = table.perfect && placed[idx];
+    return table;
+}
+
+
+/***
+ * This checks that the token titles line up with the token kinds
+ * @return true if every title matches
+ */
+constexpr bool titlesMatch()
+{
+    if (size(TOKEN_TITLES) != size(POSSIBLE_TOKENS) || TK_L_PAREN + size(TOKEN_TITLES) != TK_COUNT)
+        return false;
+    for (size_t idx = 0; idx < size(TOKEN_TITLES); idx++)
+    {
+        if (TOKEN_KIND_TITLES[TK_L_PAREN + idx] != TOKEN_TITLES[idx])
+            return false;
+    }
+    return true;
+}
+
+
+static constexpr keywordTable KEYWORD_TABLE = buildKeywordTable();
+static_assert(KEYWORD_TABLE.perfect, "the keyword table needs more slots or buckets");
+static_assert(titlesMatch(), "TOKEN_TITLES must be in the same order as the token kinds");
+
+static constexpr keywordEntry NOT_A_KEYWORD = {"", TK_UNKNOWN, KW_NONE, 0};
+
+
+/***
+ * This looks up a word in the keyword table
+ * @param text the word
+ * @return the entry for the word, or an empty entry if it is not a special token,
+ * grammar keyword or reserved word
+ */
+const keywordEntry& lookupKeyword(string_view text)
+{
+    uint32_t displace = KEYWORD_TABLE.displace[keywordHash(text, 0) % KEYWORD_BUCKETS];
+    const keywordEntry& entry = KEYWORD_TABLE.slots[keywordHash(text, displace) % KEYWORD_SLOTS];
+    if (entry.text == text && !text.empty())
+        return entry;
+    return NOT_A_KEYWORD;
+}
+
+
+/***
+ * This finds the kind of a special token
+ * @param text the token
+ * @return the kind, or TK_UNKNOWN if it is not a special token
+ */
+tokenKind punctuatorKind(string_view text)
+{
+    return lookupKeyword(text).kind;
+}
+
+
+/***
+ * This checks if the given text is in one of the given word lists
+ * @param curText string to be checked
+ * @param lists the lists to check (KF_VAR_RESERVED, KF_FUNCTION_RESERVED, KF_RETURN_TYPE)
+ * @return true if curText is in one of the lists, false if not
+ */
+bool checkReserveWord(string_view curText, uint8_t lists)
+{
+    return (lookupKeyword(curText).flags & lists) != 0;
+}
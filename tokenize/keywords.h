@@ -0,0 +1,68 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_KEYWORDS_H
+#define ASSIGNMENT5_KEYWORDS_H
+#include "tokenKind.h"
+#include <cstdint>
+#include <string_view>
+using namespace std;
+
+
+// These are the arrays associated with the special tokens (POSSIBLE_TOKENS being the tokens themselves,
+// TOKEN_TITLES being their names, VAR_RESERVED_WORDS being a list of invalid variable names,
+// FUNCTION_SPECIFIC_RESERVES being a list of invalid function names, and POSSIBLE_RETURN_TYPES being
+// a list of valid function return types), every word in them is put in the keyword table below
+
+constexpr string_view TOKEN_TITLES[] = {"L_PAREN", "R_PAREN", "L_BRACE", "R_BRACE", "L_BRACKET", "R_BRACKET", "SEMICOLON",
+                                        "ASSIGNMENT_OPERATOR", "MODULO", "PLUS", "MINUS", "DIVIDE", "ASTERISK", "DOUBLE_QUOTE",
+                                        "SINGLE_QUOTE", "COMMA", "CARET", "LT", "GT", "LT_EQUAL", "GT_EQUAL", "BOOLEAN_AND",
+                                        "BOOLEAN_OR", "BOOLEAN_NOT", "BOOLEAN_EQUAL", "BOOLEAN_NOT_EQUAL", "BOOLEAN_TRUE",
+                                        "BOOLEAN_FALSE"};
+
+constexpr string_view POSSIBLE_TOKENS[] = {"(", ")", "{", "}", "[", "]", ";", "=", "%", "+", "-","/", "*", "\"", "\'", ",", "^",
+                                           "<", ">", "<=", ">=", "&&", "||", "!", "==", "!=", "true", "false"};
+
+
+constexpr string_view VAR_RESERVED_WORDS[] = {"alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor",
+                                              "bool","break", "case", "catch", "char", "char16_t", "char32_t", "class",
+                                              "compl","const", "constexpr", "const_cast", "continue", "decltype",
+                                              "default","delete", "do", "double", "dynamic_cast","else", "enum",
+                                              "explicit","export", "extern", "false", "float", "for", "friend", "goto",
+                                              "if","inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+                                              "not", "not_eq", "nullptr", "operator", "or", "or_eq", "register",
+                                              "reinterpret_cast", "return", "short",  "signed", "sizeof", "static",
+                                              "static_assert", "static_cast", "struct", "switch", "template",
+                                              "thread_local", "throw", "true", "typedef", "typeid", "typename", "union",
+                                              "unsigned", "virtual", "void", "volatile", "wchar_t", "while",
+                                              "xor", "xor_eq"};
+
+constexpr string_view FUNCTION_SPECIFIC_RESERVES[] = {"sizeof", "alignof", "typeid", "decltype", "new", "delete",
+                                                      "printf"};
+
+constexpr string_view POSSIBLE_RETURN_TYPES[] = {"int", "float", "char", "double", "long", "bool", "void"};
+
+
+// which of the word lists a word is in (a word can be in more than one)
+enum keywordFlag : uint8_t {
+    KF_VAR_RESERVED = 1, KF_FUNCTION_RESERVED = 2, KF_RETURN_TYPE = 4
+};
+
+
+// Everything known about a word: the special token it is (TK_UNKNOWN if none), the
+// grammar keyword it is (KW_NONE if none) and the lists it is in
+struct keywordEntry {
+    string_view text;
+    tokenKind kind;
+    keywordKind word;
+    uint8_t flags;
+};
+
+
+const keywordEntry& lookupKeyword(string_view text);
+tokenKind punctuatorKind(string_view text);
+bool checkReserveWord(string_view curText, uint8_t lists);
+
+
+#endif //ASSIGNMENT5_KEYWORDS_H
@@ -0,0 +1,507 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "lexer.h"
+#include "tokenize.h"
+#include "keywords.h"
+#include "../threadPool/threadPool.h"
+#include "../simdScan/simdScan.h"
+#include <algorithm>
+#include <memory>
+#include "../removeComments/removeComments.h"
+using namespace std;
+
+
+// character classes used to index the transition table
+enum charClass : uint8_t { CC_LETTER, CC_DIGIT, CC_SPACE, CC_DQUOTE, CC_SQUOTE, CC_LBRACKET, CC_RBRACKET, CC_MINUS,
+                           CC_BOOL, CC_SEMI, CC_PUNCT, CC_OTHER, CC_COUNT };
+
+// what the previous character was (only quotes, '[' and '\' change a transition)
+enum prevKind : uint8_t { PK_OTHER, PK_BACKSLASH, PK_DQUOTE, PK_SQUOTE, PK_LBRACKET, PK_COUNT };
+
+// what the next character on the line is (NK_NONE is the end of the line)
+enum nextKind : uint8_t { NK_NONE, NK_DIGIT, NK_BOOL, NK_OTHER, NK_COUNT };
+
+
+/***
+ * This classifies a single character (same rules as isalpha/isdigit/checkToken
+ * on a converted char, but usable at compile time)
+ * @param c the character
+ * @return the class of the character
+ */
+constexpr uint8_t classify(unsigned char c)
+{
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+        return CC_LETTER;
+    if (c >= '0' && c <= '9')
+        return CC_DIGIT;
+    switch (c)
+    {
+        case ' ': return CC_SPACE;
+        case '\"': return CC_DQUOTE;
+        case '\'': return CC_SQUOTE;
+        case '[': return CC_LBRACKET;
+        case ']': return CC_RBRACKET;
+        case '-': return CC_MINUS;
+        case '<': case '>': case '=': case '&': case '|': return CC_BOOL;
+        case ';': return CC_SEMI;
+        case '(': case ')': case '{': case '}': case '%': case '+': case '/': case '*': case ',': case '^': case '!':
+            return CC_PUNCT;
+        default: return CC_OTHER;
+    }
+}
+
+
+/***
+ * This computes the next state for one combination of inputs, it follows the
+ * original state() function case by case and is only ever run at compile time
+ * @param state the current state
+ * @param cls class of the current char
+ * @param prev kind of the previous char
+ * @param next kind of the next char on the line
+ * @param textEmpty true if there is no text waiting to become a token
+ * @return the next state
+ */
+constexpr uint8_t computeState(uint8_t state, uint8_t cls, uint8_t prev, uint8_t next, bool textEmpty)
+{
+    switch (state)
+    {
+        case 0:
+            break;
+        // currently in double/single quote
+        case 3:
+            return (prev != PK_BACKSLASH && cls == CC_DQUOTE) ? 6 : 3;
+        case 4:
+            return (prev != PK_BACKSLASH && cls == CC_SQUOTE) ? 6 : 4;
+        // buffer states
+        case 5: case 6:
+            return 7;
+        // starting a string (or an index)
+        case 8:
+            if (prev == PK_DQUOTE)
+                return cls == CC_DQUOTE ? 1 : 3;
+            if (prev == PK_SQUOTE)
+                return cls == CC_SQUOTE ? 1 : 4;
+            if (prev == PK_LBRACKET)
+                return cls == CC_RBRACKET ? 1 : 13;
+            // falls into the bracket state without leaving state 8
+            return cls == CC_RBRACKET ? 14 : 8;
+        // in bracket
+        case 13:
+            return cls == CC_RBRACKET ? 14 : 13;
+        // boolean
+        case 9:
+            return 10;
+        // everything else resets to 0 and is checked as a normal char
+        default:
+            break;
+    }
+
+    if (cls == CC_LETTER)
+        return next == NK_NONE ? 11 : 0;
+    if (cls == CC_DIGIT || cls == CC_OTHER)
+        return 0;
+    if (cls == CC_SPACE)
+        return 2;
+
+    // special (single char) tokens
+    if (cls == CC_LBRACKET || ((cls == CC_DQUOTE || cls == CC_SQUOTE) && prev != PK_BACKSLASH))
+        return 8;
+    if (cls == CC_MINUS)
+        return next == NK_DIGIT ? 0 : 1;
+    if (cls == CC_BOOL)
+        return next == NK_BOOL ? 9 : 1;
+    if (cls == CC_SEMI || !textEmpty)
+        return 5;
+    return 1;
+}
+
+
+struct lexTables {
+    uint8_t charClass[256];
+    uint8_t prevKind[256];
+    uint8_t nextKind[256];
+    uint8_t next[LEX_STATES][CC_COUNT][PK_COUNT][NK_COUNT][2];
+};
+
+
+/***
+ * This builds every table used by the lexer
+ * @return the filled in tables
+ */
+constexpr lexTables buildTables()
+{
+    lexTables tables{};
+    for (int c = 0; c < 256; c++)
+    {
+        uint8_t cls = classify(c);
+        tables.charClass[c] = cls;
+        tables.prevKind[c] = c == '\\' ? PK_BACKSLASH : cls == CC_DQUOTE ? PK_DQUOTE : cls == CC_SQUOTE ? PK_SQUOTE :
+                             cls == CC_LBRACKET ? PK_LBRACKET : PK_OTHER;
+        tables.nextKind[c] = cls == CC_DIGIT ? NK_DIGIT : cls == CC_BOOL ? NK_BOOL : NK_OTHER;
+    }
+
+    for (int state = 0; state < LEX_STATES; state++)
+        for (int cls = 0; cls < CC_COUNT; cls++)
+            for (int prev = 0; prev < PK_COUNT; prev++)
+                for (int next = 0; next < NK_COUNT; next++)
+                    for (int textEmpty = 0; textEmpty < 2; textEmpty++)
+                        tables.next[state][cls][prev][next][textEmpty] =
+                                computeState(state, cls, prev, next, textEmpty);
+    return tables;
+}
+
+static constexpr lexTables LEX_TABLES = buildTables();
+
+
+/***
+ * This adds a token whose text is a piece of the current line
+ * @param kind the kind of token
+ * @param idx index in the line where the text starts
+ * @param length length of the text
+ * @param word the grammar keyword it is (identifiers only)
+ */
+void lexer::emit(tokenKind kind, int idx, int length, keywordKind word)
+{
+    auto offset = (uint32_t) (curLine.data() - TB->source().data()) + idx;
+    TB->add(kind, offset, length, lineNum, word);
+}
+
+
+/***
+ * This adds a token holding the collected text, the text is a view into the
+ * source unless chars were skipped while collecting it
+ * @param kind the kind of token
+ * @param word the grammar keyword it is (identifiers only)
+ */
+void lexer::emitText(tokenKind kind, keywordKind word)
+{
+    if (curLine.compare(textStart, curText.size(), curText) == 0)
+        emit(kind, textStart, (int) curText.size(), word);
+    else
+        TB->addText(kind, curText, lineNum, word);
+}
+
+
+/***
+ * This adds a char to the collected text
+ * @param idx index of the char in the line
+ * @param curChar the char
+ */
+void lexer::append(int idx, char curChar)
+{
+    if (curText.empty())
+        textStart = idx;
+    curText += curChar;
+}
+
+
+/***
+ * This turns the collected text into an identifier/integer token and keeps track of
+ * declarations to catch invalid integers (states 2, 5 and 11)
+ * @return false if an invalid integer was found, true if not
+ */
+bool lexer::emitWord()
+{
+    if (curText.empty())
+        return true;
+
+    bool isInteger = isIntText(curText);
+    // a single probe of the keyword table tells us everything we need about the word
+    const keywordEntry& entry = lookupKeyword(curText);
+    if (entry.word == KW_FUNCTION || entry.word == KW_PROCEDURE)
+    {
+        if (entry.word == KW_FUNCTION)
+            functionDeclaration = true;
+    }
+    else if (functionDeclaration)
+    {
+        if (isInteger)
+            return false;
+        functionDeclaration = false;
+        variableDeclaration = true;
+        funcName = true;
+    }
+    else if (!variableDeclaration && (entry.flags & KF_VAR_RESERVED))
+    {
+        variableDeclaration = true;
+    }
+    else if (variableDeclaration)
+    {
+        // check for invalid integer placement in an identifier
+        if (isInteger)
+            return false;
+        variableDeclaration = funcName = false;
+    }
+
+    if (isInteger)
+        emitText(TK_INTEGER);
+    // string is not entirely an integer, check if invalid integer placement in name
+    else if (LEX_TABLES.charClass[(unsigned char) curText[0]] == CC_DIGIT)
+        return false;
+    else
+        emitText(TK_IDENTIFIER, entry.word);
+
+    curText.clear();
+    return true;
+}
+
+
+/***
+ * This handles a run of chars that leave the state alone in one step instead of going
+ * through the transition table for each of them
+ * 0: letters/digits/underscores are added to the collected text (the last char of the
+ *    line is left for the table since a letter there ends the token)
+ * 2: spaces between tokens are skipped
+ * 3/4: chars in a string up to the next unescaped closing quote are collected
+ * @param idx index in the current line of the first char of the run
+ * @param stateNum the current state
+ * @return index of the first char that has to go through the table
+ */
+int lexer::skipRun(int idx, uint8_t stateNum)
+{
+    auto start = (size_t) idx;
+    size_t end = start;
+    switch (stateNum)
+    {
+        case 0:
+            end = min(skipWordChars(curLine, start), curLine.size() - 1);
+            break;
+        case 2:
+            if (curText.empty())
+                end = skipSpaces(curLine, start);
+            break;
+        case 3: case 4:
+        {
+            char quote = stateNum == 3 ? '\"' : '\'';
+            end = findChar(curLine, start, quote);
+            while (end < curLine.size() && (end == start ? prevChar : curLine[end - 1]) == '\\')
+                end = findChar(curLine, end + 1, quote);
+            break;
+        }
+        default:
+            break;
+    }
+    if (end <= start)
+        return idx;
+
+    if (stateNum != 2)
+    {
+        if (curText.empty())
+            textStart = idx;
+        curText.append(curLine.substr(start, end - start));
+    }
+    prevChar = curLine[end - 1];
+    return (int) end;
+}
+
+
+/***
+ * This lexes a single line of the program and adds its tokens (and an endl token)
+ * to the token list
+ * @param line the line without its newline
+ * @return false if an invalid integer was found, true if not
+ */
+bool lexer::lexLine(string_view line)
+{
+    uint8_t stateNum = 0;
+    int size = (int) line.size();
+
+    curLine = line;
+
+    // reset the collected text and declaration flags
+    curText.clear();
+    textStart = 0;
+    variableDeclaration = functionDeclaration = funcName = false;
+
+    for (int i = 0; i < size; i++)
+    {
+        i = skipRun(i, stateNum);
+        if (i == size)
+            break;
+
+        char curChar = line[i];
+        uint8_t next = i + 1 < size ? LEX_TABLES.nextKind[(unsigned char) line[i + 1]] : (uint8_t) NK_NONE;
+        stateNum = LEX_TABLES.next[stateNum][LEX_TABLES.charClass[(unsigned char) curChar]]
+                                  [LEX_TABLES.prevKind[(unsigned char) prevChar]][next][curText.empty()];
+
+        switch (stateNum)
+        {
+            // special tokens
+            case 1: case 7: case 8: case 10:
+            {
+                if (stateNum == 8 && !curText.empty())
+                {
+                    emitText(TK_IDENTIFIER, lookupKeyword(curText).word);
+                    curText.clear();
+                }
+                // multi-char booleans (==, >=, etc) include the collected text
+                if (stateNum == 10)
+                {
+                    append(i, curChar);
+                    emitText(punctuatorKind(curText));
+                }
+                else
+                    emit(punctuatorKind(line.substr(i, 1)), i, 1);
+
+                if (stateNum != 8)
+                    stateNum = 0;
+                curText.clear();
+                break;
+            }
+            // end of the line (for conditionals)
+            case 11:
+            {
+                append(i, curChar);
+                [[fallthrough]];
+            }
+            // non-special character token
+            case 2: case 5:
+            {
+                if (!emitWord())
+                {
+                    integerError = true;
+                    return false;
+                }
+                // reread the char that ended the token
+                if (stateNum == 5)
+                    i--;
+                break;
+            }
+            // in a string
+            case 3: case 4:
+            {
+                append(i, curChar);
+                break;
+            }
+            // end of string (reread the closing quote)
+            case 6:
+            {
+                emitText(TK_STRING);
+                curText.clear();
+                i--;
+                break;
+            }
+            // end of an array index
+            case 14:
+            {
+                if (isIntText(curText))
+                    emitText(TK_INTEGER);
+                else
+                    emitText(TK_IDENTIFIER, lookupKeyword(curText).word);
+                curText.clear();
+                [[fallthrough]];
+            }
+            default:
+            {
+                if (curChar != ' ')
+                    append(i, curChar);
+            }
+        }
+        prevChar = curChar;
+    }
+
+    // current line is over
+    emit(TK_ENDL, size, 0);
+    lineNum++;
+    return true;
+}
+
+
+/***
+ * This lexes the whole program
+ * @return false if an invalid integer was found, true if not
+ */
+bool lexer::run()
+{
+    while (lexNextLine()) {}
+    return !integerError;
+}
+
+
+/***
+ * This lexes the line after the last one lexed (used by token streams, which lex on
+ * demand)
+ * @return true if a line was lexed, false at the end of the program or if an invalid
+ * integer was found
+ */
+bool lexer::lexNextLine()
+{
+    string_view line;
+    if (integerError || !nextLine(_source, sourcePos, line))
+        return false;
+    return lexLine(line);
+}
+
+
+/***
+ * This lexes a large program on the shared thread pool. The program is split into line
+ * aligned chunks, the only state a line takes from the lines before it is the line number
+ * and the last char before it (prevChar), both are worked out before the chunks are lexed
+ * so each chunk produces exactly the tokens the serial lexer would
+ * @param source the whole program (the buffer must have been created with it)
+ * @param TB the buffer that gets every token, in order
+ * @param errorLine set to the line of the first invalid integer if there is one
+ * @return false if an invalid integer was found, true if not
+ */
+bool lexParallel(string_view source, tokenBuffer * TB, int& errorLine)
+{
+    threadPool& pool = threadPool::shared();
+    size_t chunkCount = min<size_t>(pool.size() * 4, max<size_t>(1, source.size() / MIN_LEX_CHUNK_BYTES));
+
+    vector<size_t> starts = splitLines(source, chunkCount);
+    chunkCount = starts.size() - 1;
+
+    // count the lines of every chunk and find the last char of each chunk (empty lines
+    // leave prevChar unchanged, so a chunk of only empty lines has no last char)
+    vector<int> lineCounts(chunkCount);
+    vector<int> lastChars(chunkCount, -1);
+    pool.run(chunkCount, [&](size_t chunk)
+    {
+        string_view text = source.substr(starts[chunk], starts[chunk + 1] - starts[chunk]);
+        lineCounts[chunk] = (int) count(text.begin(), text.end(), '\n');
+        size_t last = text.find_last_not_of('\n');
+        if (last != string_view::npos)
+            lastChars[chunk] = (unsigned char) text[last];
+    });
+
+    // fix up pass: the line number and prevChar each chunk starts with
+    vector<int> firstLines(chunkCount, 1);
+    vector<char> prevChars(chunkCount, '\0');
+    for (size_t chunk = 1; chunk < chunkCount; chunk++)
+    {
+        firstLines[chunk] = firstLines[chunk - 1] + lineCounts[chunk - 1];
+        prevChars[chunk] = lastChars[chunk - 1] >= 0 ? (char) lastChars[chunk - 1] : prevChars[chunk - 1];
+    }
+
+    vector<unique_ptr<tokenBuffer>> buffers(chunkCount);
+    vector<int> errors(chunkCount, 0);
+    pool.run(chunkCount, [&](size_t chunk)
+    {
+        string_view text = source.substr(starts[chunk], starts[chunk + 1] - starts[chunk]);
+        buffers[chunk] = make_unique<tokenBuffer>(source);
+        buffers[chunk]->reserve(text.size() / 3);
+        lexer lex(text, buffers[chunk].get(), firstLines[chunk], prevChars[chunk]);
+        if (!lex.run())
+            errors[chunk] = lex.lineNumber();
+    });
+
+    // the serial lexer stops at the first invalid integer
+    for (size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        if (errors[chunk])
+        {
+            errorLine = errors[chunk];
+            return false;
+        }
+    }
+
+    size_t total = 0;
+    for (const auto& buffer : buffers)
+        total += buffer->size();
+    TB->reserve(total);
+    for (const auto& buffer : buffers)
+        TB->append(*buffer);
+    return true;
+}
@@ -0,0 +1,84 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_LEXER_H
+#define ASSIGNMENT5_LEXER_H
+#include "tokenBuffer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+using namespace std;
+
+
+/***
+ * STATE KEY (same numbering as the original state() function)
+ * 0: Normal state
+ * 1: single char
+ * 2: identifier
+ * 3: double quote
+ * 4: single quote
+ * 5: buffer (end of line or regular token)
+ * 6: quote buffer
+ * 7: string
+ * 8: quote
+ * 9: Boolean Expression
+ * 10: Boolean Buffer
+ * 11: end of line
+ * 12: true/false buffer
+ * 13: bracket (for array size/idx)
+ * 14: out of bracket (check for error)
+ */
+const int LEX_STATES = 15;
+
+// programs at least this large are lexed in parallel, and every chunk holds at least
+// this many bytes
+const size_t PARALLEL_LEX_BYTES = 1 << 20;
+const size_t MIN_LEX_CHUNK_BYTES = 1 << 18;
+
+
+/***
+ * This is a table driven lexer, the next state for every character is looked up
+ * in a transition table that is built at compile time (see lexer.cpp) so the
+ * hot loop does not build any temporary strings
+ */
+class lexer {
+
+public:
+    lexer(string_view source, tokenBuffer * TB): _source{source}, TB{TB} { curText.reserve(64); }
+    lexer(string_view source, tokenBuffer * TB, int firstLine, char prevChar): _source{source}, TB{TB},
+    lineNum{firstLine}, prevChar{prevChar} { curText.reserve(64); }
+
+    bool run();
+    bool lexLine(string_view line);
+    bool lexNextLine();
+    [[nodiscard]] int lineNumber() const { return lineNum; }
+    [[nodiscard]] bool hasError() const { return integerError; }
+
+private:
+    void emit(tokenKind kind, int idx, int length, keywordKind word = KW_NONE);
+    void emitText(tokenKind kind, keywordKind word = KW_NONE);
+    void append(int idx, char curChar);
+    bool emitWord();
+    int skipRun(int idx, uint8_t stateNum);
+
+    string_view _source;
+    size_t sourcePos = 0; // start of the next line to be lexed
+    string_view curLine;
+    tokenBuffer * TB;
+    string curText;
+    int textStart = 0; // index in the line of the first char of curText
+    int lineNum = 1;
+    char prevChar = '\0';
+    bool integerError = false;
+
+    // declaration flags (reset at the start of every line)
+    bool variableDeclaration = false, functionDeclaration = false, funcName = false;
+
+};
+
+
+bool lexParallel(string_view source, tokenBuffer * TB, int& errorLine);
+
+
+#endif //ASSIGNMENT5_LEXER_H
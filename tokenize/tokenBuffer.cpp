@@ -0,0 +1,268 @@
+//
+// Created on 10/17/2026.
+//
+
+#include "tokenBuffer.h"
+#include "tokenize.h"
+#include "lexer.h"
+#include <iostream>
+#include <fstream>
+using namespace std;
+
+
+/***
+ * Destructor (a stream owns the lexer that fills it)
+ */
+tokenBuffer::~tokenBuffer()
+{
+    delete _pull;
+}
+
+
+/***
+ * This adds a token whose text is a piece of the source
+ * @param kind the kind of token
+ * @param offset where the text starts in the source
+ * @param length length of the text
+ * @param line line number of the token
+ * @param word the grammar keyword it is (identifiers only)
+ */
+void tokenBuffer::add(tokenKind kind, uint32_t offset, uint32_t length, uint32_t line, keywordKind word)
+{
+    push(kind, offset, _source.substr(offset, length), line, word);
+}
+
+
+/***
+ * This adds a token whose text is not a single piece of the source (the text is
+ * copied after the end of the source)
+ * @param kind the kind of token
+ * @param text the text of the token
+ * @param line line number of the token
+ * @param word the grammar keyword it is (identifiers only)
+ */
+void tokenBuffer::addText(tokenKind kind, string_view text, uint32_t line, keywordKind word)
+{
+    auto offset = (uint32_t) (_source.size() + _extraBase + _extra.size());
+    _extra.append(text);
+    push(kind, offset, text, line, word);
+}
+
+
+/***
+ * This stores a token, integers have their value decoded here so that it is only
+ * parsed once and the text is interned (keywords and special tokens already know
+ * their ID, string literals are not interned and get ID 0)
+ * @param kind the kind of token
+ * @param offset where the text of the token is stored
+ * @param text the text of the token
+ * @param line line number of the token
+ * @param word the grammar keyword it is (identifiers only)
+ */
+void tokenBuffer::push(tokenKind kind, uint32_t offset, string_view text, uint32_t line, keywordKind word)
+{
+    int value = 0;
+    bool inRange = kind != TK_INTEGER || decodeInteger(text, value);
+
+    uint32_t id;
+    if (kind >= TK_L_PAREN)
+        id = punctuatorId(kind);
+    else if (word != KW_NONE)
+        id = keywordId(word);
+    else if (text.empty() || kind == TK_STRING)
+        id = 0;
+    else
+        id = interner::global().intern(text);
+    _tokens.push_back({offset, (uint32_t) text.size(), line, id, value, kind, word, inRange});
+}
+
+
+/***
+ * This adds every token of another buffer over the same source to the end of this one
+ * @param other the buffer to be copied
+ */
+void tokenBuffer::append(const tokenBuffer& other)
+{
+    // text stored after the source moves by the length of the text already stored here
+    auto shift = (uint32_t) _extra.size();
+    for (compactToken _token : other._tokens)
+    {
+        if (_token.offset >= _source.size() && _token.length > 0)
+            _token.offset += shift;
+        _tokens.push_back(_token);
+    }
+    _extra.append(other._extra);
+}
+
+
+/***
+ * This gets the text of a token
+ * @param _token the token
+ * @return a view of the text (valid while the buffer and source exist)
+ */
+string_view tokenBuffer::text(const compactToken& _token) const
+{
+    if (_token.offset < _source.size())
+        return _source.substr(_token.offset, _token.length);
+    return string_view(_extra).substr(_token.offset - _source.size() - _extraBase, _token.length);
+}
+
+
+/***
+ * This is used for debugging purposes to see whether a token buffer is properly
+ * constructed (same format as tokenList::output)
+ * @param outputFile file where the output is held
+ */
+void tokenBuffer::output(const string& outputFile) const
+{
+    ofstream outFS;
+    outFS.open(outputFile);
+
+    if (!outFS.is_open())
+    {
+        cout << "ERROR OPENING " << outputFile << endl;
+        exit(3);
+    }
+
+    outFS << "\nToken list:\n\n";
+    for (const compactToken& _token : _tokens)
+        writeToken(outFS, _token);
+
+    outFS.close();
+}
+
+
+/***
+ * This writes one token in the token list output format
+ * @param outFS the output file stream
+ * @param _token the token
+ */
+void tokenBuffer::writeToken(ofstream& outFS, const compactToken& _token) const
+{
+    outFS << "Token type: " << TOKEN_KIND_TITLES[_token.kind] << '\n';
+    outFS << "Token:      " << text(_token) << "\n\n";
+}
+
+
+/***
+ * This turns an empty buffer into a stream, tokens are lexed a line at a time when
+ * the parser asks for one past the end of the buffer. Each line's tokens are written
+ * to the token output file as they are lexed, so it ends up the same as output()
+ * would make it
+ * @param pull the lexer over this buffer's source (the buffer deletes it)
+ * @param outputFile the file that holds the token output
+ */
+void tokenBuffer::stream(lexer * pull, const string& outputFile)
+{
+    _pull = pull;
+    tokenDumpFile = outputFile;
+    tokenDump.open(outputFile);
+
+    if (!tokenDump.is_open())
+    {
+        cout << "ERROR OPENING " << outputFile << endl;
+        exit(3);
+    }
+    tokenDump << "\nToken list:\n\n";
+}
+
+
+/***
+ * This lexes lines until the buffer holds a token (or the program ends)
+ * @param idx index of the token
+ * @return true if the token exists, false if the program has fewer tokens
+ */
+bool tokenBuffer::pull(uint32_t idx)
+{
+    // a dropped token can not be read again
+    if (idx < _base)
+        return false;
+
+    while (idx - _base >= _tokens.size())
+    {
+        size_t lexed = _tokens.size();
+        if (!_pull->lexNextLine())
+        {
+            // the stream ends at an invalid integer, the token output file only gets
+            // the error like createTokenBuffer writes it (and the tokens of the line
+            // before the error are dropped so the parser never reads them)
+            if (_pull->hasError())
+            {
+                lexError = true;
+                _tokens.resize(lexed);
+                tokenDump.close();
+                tokenDump.open(tokenDumpFile);
+                tokenDump << "Syntax error on line " << _pull->lineNumber() << ": invalid integer\n";
+            }
+            delete _pull;
+            _pull = nullptr;
+            tokenDump.close();
+            return false;
+        }
+        for (size_t tokenIdx = lexed; tokenIdx < _tokens.size(); tokenIdx++)
+            writeToken(tokenDump, _tokens[tokenIdx]);
+    }
+    return true;
+}
+
+
+/***
+ * This lexes the rest of a stream once the parser is done with it, so the token output
+ * file is complete and an invalid integer past where the parser stopped is still found
+ * (a buffer that is not a stream was lexed whole already)
+ * @return false if the program could not be lexed
+ */
+bool tokenBuffer::finish()
+{
+    while (_pull)
+    {
+        auto end = _base + (uint32_t) _tokens.size();
+        pull(end);
+        release(end);
+    }
+    return !lexError;
+}
+
+
+/***
+ * This tells a stream the parser will not read any token before idx again, the
+ * tokens are dropped once enough of them have built up (a buffer that is not a
+ * stream keeps every token)
+ * @param idx index of the first token that may still be read
+ */
+void tokenBuffer::release(uint32_t idx)
+{
+    if (!_pull || idx <= _base || idx - _base < TOKEN_WINDOW)
+        return;
+
+    idx = min(idx, _base + (uint32_t) _tokens.size());
+    _tokens.erase(_tokens.begin(), _tokens.begin() + (idx - _base));
+    _base = idx;
+
+    // the copied text can go too once no token left in the window points into it
+    bool usesExtra = false;
+    for (const compactToken& _token : _tokens)
+        usesExtra = usesExtra || (_token.offset >= _source.size() && _token.length > 0);
+    if (!usesExtra)
+    {
+        _extraBase += (uint32_t) _extra.size();
+        _extra.clear();
+    }
+}
+
+
+/***
+ * This builds a linked token list with the same tokens (for code that still uses
+ * token pointers)
+ * @return the token list
+ */
+tokenList * tokenBuffer::toList() const
+{
+    auto * TL = new tokenList;
+    for (const compactToken& _token : _tokens)
+    {
+        auto * listToken = new token(string(TOKEN_KIND_TITLES[_token.kind]), string(text(_token)));
+        TL->insert(listToken);
+    }
+    return TL;
+}
@@ -0,0 +1,137 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_TOKENBUFFER_H
+#define ASSIGNMENT5_TOKENBUFFER_H
+#include "tokenKind.h"
+#include "tokenList.h"
+#include "../interner/interner.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+class tokenBuffer;
+class lexer;
+
+
+// a token stream drops the tokens the parser is done with once this many have built up
+const size_t TOKEN_WINDOW = 1024;
+
+
+// A token is a kind plus a view (offset/length) into the program text, tokens whose
+// text is not a single piece of the program are stored after the end of the source
+struct compactToken {
+    uint32_t offset;
+    uint32_t length;
+    uint32_t line;
+    uint32_t id; // interned ID of the text
+    int32_t value; // decoded value of an integer (0 for other tokens)
+    tokenKind kind;
+    keywordKind word; // grammar keyword of an identifier (KW_NONE if it is not one)
+    bool inRange; // false if an integer does not fit in an int
+};
+
+
+/***
+ * This is a position in a token buffer, it is used by the parser the same way a
+ * token pointer was (iter->next(), iter->content(), !iter, etc). The index counts
+ * from the first token of the program even if the buffer has dropped earlier ones
+ */
+class tokenIter {
+
+public:
+    tokenIter(): buffer{nullptr}, idx{0} {}
+    tokenIter(tokenBuffer * buffer, uint32_t idx): buffer{buffer}, idx{idx} {}
+
+    explicit operator bool() const;
+    const tokenIter * operator->() const { return this; }
+
+    [[nodiscard]] tokenIter next() const { return {buffer, idx + 1}; }
+    [[nodiscard]] string_view content() const;
+    [[nodiscard]] internedString name() const;
+    [[nodiscard]] string_view _type() const { return TOKEN_KIND_TITLES[kind()]; }
+    [[nodiscard]] tokenKind kind() const;
+    [[nodiscard]] keywordKind keyword() const;
+    [[nodiscard]] int value() const;
+    [[nodiscard]] bool valueInRange() const;
+    [[nodiscard]] uint32_t line() const;
+    [[nodiscard]] uint32_t index() const { return idx; }
+    [[nodiscard]] tokenBuffer * owner() const { return buffer; }
+    [[nodiscard]] bool isEndlToken() const { return kind() == TK_ENDL; }
+    void release() const;
+
+private:
+    tokenBuffer * buffer;
+    uint32_t idx;
+};
+
+
+/***
+ * This holds every token of a program in one contiguous vector. A buffer can also be
+ * a stream (see createTokenStream), then it only holds a window of tokens, more lines
+ * are lexed when the parser reads past the end of it and the tokens the parser is done
+ * with are dropped
+ */
+class tokenBuffer {
+
+public:
+    explicit tokenBuffer(string_view source): _source{source} {}
+    ~tokenBuffer();
+
+    void add(tokenKind kind, uint32_t offset, uint32_t length, uint32_t line, keywordKind word = KW_NONE);
+    void addText(tokenKind kind, string_view text, uint32_t line, keywordKind word = KW_NONE);
+    void reserve(size_t count) { _tokens.reserve(count); }
+    void append(const tokenBuffer& other);
+    void output(const string& outputFile) const;
+    tokenList * toList() const;
+    void stream(lexer * pull, const string& outputFile);
+    bool finish();
+    bool has(uint32_t idx);
+    void release(uint32_t idx);
+
+    [[nodiscard]] string_view text(const compactToken& _token) const;
+    [[nodiscard]] size_t size() const { return _tokens.size(); }
+    [[nodiscard]] const compactToken& operator[](size_t idx) const { return _tokens[idx - _base]; }
+    [[nodiscard]] tokenIter begin() { return {this, 0}; }
+    [[nodiscard]] string_view source() const { return _source; }
+    [[nodiscard]] bool failed() const { return lexError; }
+
+private:
+    void push(tokenKind kind, uint32_t offset, string_view text, uint32_t line, keywordKind word);
+    bool pull(uint32_t idx);
+    void writeToken(ofstream& outFS, const compactToken& _token) const;
+
+    string_view _source;
+    string _extra; // text of tokens that are not a single piece of the source
+    vector<compactToken> _tokens;
+    uint32_t _base = 0; // index of _tokens[0] in the whole program (a stream drops tokens)
+    uint32_t _extraBase = 0; // length of the text dropped from the front of _extra
+
+    // only used by streams
+    lexer * _pull = nullptr;
+    string tokenDumpFile;
+    ofstream tokenDump;
+    bool lexError = false;
+
+};
+
+
+// only a stream ever has to lex more to answer this
+inline bool tokenBuffer::has(uint32_t idx) { return idx - _base < _tokens.size() || (_pull && pull(idx)); }
+
+inline tokenIter::operator bool() const { return buffer && buffer->has(idx); }
+inline void tokenIter::release() const { if (buffer) buffer->release(idx); }
+// reading past the last token gives an empty token instead of a bad read
+inline string_view tokenIter::content() const { return *this ? buffer->text((*buffer)[idx]) : string_view(); }
+inline internedString tokenIter::name() const { return internedString::fromId(*this ? (*buffer)[idx].id : 0); }
+inline tokenKind tokenIter::kind() const { return *this ? (*buffer)[idx].kind : TK_UNKNOWN; }
+inline keywordKind tokenIter::keyword() const { return *this ? (*buffer)[idx].word : KW_NONE; }
+inline int tokenIter::value() const { return *this ? (*buffer)[idx].value : 0; }
+inline bool tokenIter::valueInRange() const { return !*this || (*buffer)[idx].inRange; }
+inline uint32_t tokenIter::line() const { return *this ? (*buffer)[idx].line : 0; }
+
+
+#endif //ASSIGNMENT5_TOKENBUFFER_H
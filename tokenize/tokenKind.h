@@ -0,0 +1,88 @@
+//
+// Created on 10/17/2026.
+//
+
+#ifndef ASSIGNMENT5_TOKENKIND_H
+#define ASSIGNMENT5_TOKENKIND_H
+#include <cstdint>
+#include <string_view>
+using namespace std;
+
+
+// These are the kinds of tokens the lexer produces, the special tokens are in the
+// same order as TOKEN_TITLES/POSSIBLE_TOKENS (starting at TK_L_PAREN)
+enum tokenKind : uint8_t {
+    TK_UNKNOWN, TK_IDENTIFIER, TK_INTEGER, TK_STRING, TK_ENDL,
+    TK_L_PAREN, TK_R_PAREN, TK_L_BRACE, TK_R_BRACE, TK_L_BRACKET, TK_R_BRACKET, TK_SEMICOLON,
+    TK_ASSIGNMENT_OPERATOR, TK_MODULO, TK_PLUS, TK_MINUS, TK_DIVIDE, TK_ASTERISK, TK_DOUBLE_QUOTE,
+    TK_SINGLE_QUOTE, TK_COMMA, TK_CARET, TK_LT, TK_GT, TK_LT_EQUAL, TK_GT_EQUAL, TK_BOOLEAN_AND,
+    TK_BOOLEAN_OR, TK_BOOLEAN_NOT, TK_BOOLEAN_EQUAL, TK_BOOLEAN_NOT_EQUAL, TK_BOOLEAN_TRUE,
+    TK_BOOLEAN_FALSE, TK_COUNT
+};
+
+// the title of each kind (used by the token list output and type checks)
+constexpr string_view TOKEN_KIND_TITLES[TK_COUNT] = {
+    "", "IDENTIFIER", "INTEGER", "STRING", "endl",
+    "L_PAREN", "R_PAREN", "L_BRACE", "R_BRACE", "L_BRACKET", "R_BRACKET", "SEMICOLON",
+    "ASSIGNMENT_OPERATOR", "MODULO", "PLUS", "MINUS", "DIVIDE", "ASTERISK", "DOUBLE_QUOTE",
+    "SINGLE_QUOTE", "COMMA", "CARET", "LT", "GT", "LT_EQUAL", "GT_EQUAL", "BOOLEAN_AND",
+    "BOOLEAN_OR", "BOOLEAN_NOT", "BOOLEAN_EQUAL", "BOOLEAN_NOT_EQUAL", "BOOLEAN_TRUE",
+    "BOOLEAN_FALSE"
+};
+
+// These are indexed by kind, the precedence of each operator written between two
+// operands (lower binds tighter, 0 if the kind is not one), whether it groups right to
+// left, whether it can be written before an operand of its own and whether it makes an
+// expression a boolean expression
+constexpr int OPERATOR_PRECEDENCE[TK_COUNT] = {
+    0, 0, 0, 0, 0, // unknown, identifier, integer, string, endl
+    0, 0, 0, 0, 0, 0, 0, // ( ) { } [ ] ;
+    8, 2, 3, 3, 2, 2, // = % + - / *
+    0, 0, 0, 0, // " ' , ^
+    4, 4, 4, 4, 6, 7, 0, 5, 5, // < > <= >= && || ! == !=
+    0, 0 // true false
+};
+constexpr bool RIGHT_ASSOCIATIVE[TK_COUNT] = {
+    false, false, false, false, false,
+    false, false, false, false, false, false, false,
+    true, false, false, false, false, false,
+    false, false, false, false,
+    false, false, false, false, false, false, false, false, false,
+    false, false
+};
+constexpr bool PREFIX_OPERATOR[TK_COUNT] = {
+    false, false, false, false, false,
+    false, false, false, false, false, false, false,
+    false, false, false, true, false, false,
+    false, false, false, false,
+    false, false, false, false, false, false, true, false, false,
+    false, false
+};
+constexpr bool BOOLEAN_OPERATOR[TK_COUNT] = {
+    false, false, false, false, false,
+    false, false, false, false, false, false, false,
+    false, false, false, false, false, false,
+    false, false, false, false,
+    true, true, true, true, true, true, true, true, true,
+    false, false
+};
+// - and ! before an operand bind tighter than any operator between two operands, and
+// an expression takes every operator (one past the loosest)
+constexpr int PREFIX_PRECEDENCE = 1;
+constexpr int EXPRESSION_PRECEDENCE = 9;
+
+// These are the words the grammar looks for, identifier tokens carry one of these
+// (KW_NONE for any other name) so the parser can check for them without comparing text
+enum keywordKind : uint8_t {
+    KW_NONE, KW_FUNCTION, KW_PROCEDURE, KW_MAIN, KW_IF, KW_ELSE, KW_WHILE, KW_FOR, KW_RETURN, KW_PRINTF,
+    KW_GETCHAR, KW_VOID, KW_INT, KW_CHAR, KW_BOOL, KW_TRUE, KW_FALSE, KW_COUNT
+};
+
+// the text of each grammar keyword
+constexpr string_view KEYWORD_TITLES[KW_COUNT] = {
+    "", "function", "procedure", "main", "if", "else", "while", "for", "return", "printf",
+    "getchar", "void", "int", "char", "bool", "TRUE", "FALSE"
+};
+
+
+#endif //ASSIGNMENT5_TOKENKIND_H
@@ -5,28 +5,17 @@
 #include <iostream>
 #include<string>
 #include "tokenize.h"
+#include "lexer.h"
+#include "../threadPool/threadPool.h"
 #include <vector>
 #include <fstream>
 #include <cassert>
 #include <algorithm>
+#include <sstream>
+#include <charconv>
 using namespace std;
 
 
-/***
- * This iterates through a given vector and checks if the given text is one of the elements of that
- * vector (using any_of)
- * @param curText string to be checked
- * @param list vector with elements to be compared to
- * @return true if curText is equal to one of the elements, false if not
- */
-bool checkReserveWord(const string& curText, const vector<string>& list)
-{
-    return any_of(list.begin(), list.end(), [&curText](const string& i)
-    {return i == curText;});
-
-}
-
-
 /***
  * This converts a character into a string that solely contains that character
  * @param curChar given char value
@@ -41,35 +30,59 @@ string convertChar(const char& curChar)
 
 /***
  * This function checks if a non-empty string is solely a signed/unsigned integer (in a string)
- * by traversing each index of the array and calling isNumber (a helper function)
  * @param curText the string to be traversed
- * @return the related title to the token if it is a special token, an empty string if not
+ * @return true if it is an integer, false if not
  */
 bool isInt(const string& curText)
 {
     assert(!curText.empty());
-    int count = 0, startIdx = 0;
-    unsigned long long size = curText.size();
+    return isIntText(curText);
+}
 
-    if (curText[0] == '-' || curText[0] == '+')
-    {
-        startIdx = 1;
-    }
 
+/***
+ * This checks if a piece of text is solely a signed/unsigned integer without building
+ * any strings or throwing
+ * @param text the text to be checked
+ * @return true if it is an integer, false if not (an empty string is not an integer)
+ */
+bool isIntText(string_view text)
+{
+    size_t start = (!text.empty() && (text[0] == '-' || text[0] == '+')) ? 1 : 0;
 
-    for (int i = startIdx; i < size; i++)
+    // this ensures that there is at least one digit (string is not solely a minus/plus sign)
+    if (start == text.size())
+        return false;
+    for (size_t i = start; i < text.size(); i++)
     {
-        char curChar = curText[i];
-        if (isNumber(convertChar(curChar)))
-        {
-            count++;
+        if (text[i] < '0' || text[i] > '9')
+            return false;
+    }
+    return true;
+}
 
-        }
 
+/***
+ * This decodes the value of an integer token once so later stages do not have to parse
+ * the text again
+ * @pre isIntText returns true for the text
+ * @param text the text of the integer
+ * @param value set to the value of the integer (0 if it does not fit in an int)
+ * @return true if the value fits in an int, false if it overflows
+ */
+bool decodeInteger(string_view text, int& value)
+{
+    // from_chars does not accept a leading plus sign
+    if (!text.empty() && text[0] == '+')
+        text.remove_prefix(1);
+
+    auto [end, error] = from_chars(text.data(), text.data() + text.size(), value);
+    if (error != errc() || end != text.data() + text.size())
+    {
+        value = 0;
+        return false;
     }
-    // this ensures that the count is at least 1 (string is not solely a minus/plus sign)
-    // and the amount of non-sign characters is the count (there is only one count)
-    return (count == size - startIdx && count > 0);
+    return true;
 }
 
 
@@ -86,47 +99,32 @@ bool isBoolean(const string& curText)
 
 /***
  * This function checks a string to see if it is possible to convert it to an integer, meaning that it will return
- * true if the string only contains integers (and sign if applicable)
+ * true if the string starts with an integer (after any whitespace and sign, the same strings stoi accepts)
  * @param curText the string to viewed
  * @return true if the string only contains integer/related values, false if not
  */
 int isNumber(const string& curText)
 {
-    try
-    {
-        stoi(curText);
-    }
-    catch (const invalid_argument& e)
-    {
-        return false;
-    }
-
-    return true;
+    size_t idx = 0;
+    while (idx < curText.size() && isspace((unsigned char) curText[idx]))
+        idx++;
+    if (idx < curText.size() && (curText[idx] == '-' || curText[idx] == '+'))
+        idx++;
+    return idx < curText.size() && isdigit((unsigned char) curText[idx]);
 }
 
 
 /***
- * This function checks an array of special characters to see if the current char is one of them
- * @param currentText
- * @return
+ * This function checks the keyword table to see if the current text is one of the special tokens
+ * @param currentText the text to be checked
+ * @return the related title to the token if it is a special token, an empty string if not
  */
 string checkToken(const string& currentText)
 {
-    // ensures that the vectors are the same size
-    assert(TOKEN_TITLES.size() == POSSIBLE_TOKENS.size());
-    if (!currentText.empty() && currentText != " ")
-    {
-        for (int idx = 0; idx < POSSIBLE_TOKENS.size(); idx++)
-        {
-            if (currentText == POSSIBLE_TOKENS[idx])
-            {
-                return TOKEN_TITLES[idx];
-            }
-
-        }
-    }
-    return "";
-
+    tokenKind kind = punctuatorKind(currentText);
+    if (kind == TK_UNKNOWN)
+        return "";
+    return string(TOKEN_KIND_TITLES[kind]);
 }
 
 
@@ -156,187 +154,96 @@ bool beginningOfBoolean(const string& curText)
 
 
 /***
- * This function determines the next state given parameters related to the
- * current place in the program
- *
- * @param state the given state
- * @param curChar the current char
- * @param prevChar previous char
- * @param currentText a holder for multi-character tokens
- * @param idx current idx in the current line of the program
- * @param cL current line string
- * @return the next state
- *
- *  * STATE KEY
- * 0: Normal state
- * 1: single char
- * 2: identifier
- * 3: double quote
- * 4: single quote
- * 5: buffer (end of line or regular token)
- * 6: quote buffer
- * 7: string
- * 8: quote
- * 9: Boolean Expression
- * 10: Boolean Buffer
- * 11: end of line
- * 12: true/false buffer
- * 13: bracket (for array size/idx)
- * 14: out of bracket (check for error)
+ * This function iterates through a program held in memory and creates a token
+ * buffer of its contents
+ * @param source the program (without comments), it must outlive the buffer
+ * @param outputFile the file that will hold the token output if no errors
+ * are encountered (or the error if one is)
+ * @return the token buffer, or null if an error is encountered
  */
-int state(int& state, const char& curChar, const char& prevChar, const string& currentText,
-          const int& idx, string cL)
+tokenBuffer * createTokenBuffer(string_view source, const string& outputFile)
 {
+    ofstream outFS;
+    auto * TB = new tokenBuffer(source);
+
+    outFS.open(outputFile);
+
+    // ensure the file opened correctly
+    if (!outFS.is_open())
+    {
+        cout << "ERROR OPENING -> " << outputFile << endl;
+        exit(1);
+    }
 
-    if (state != 0) {
-
-        switch (state) {
-
-            // currently in double quote
-            case 3: {
-                if (prevChar != '\\') {
-                    if (curChar == '\"')
-                        state = 6;
-                }
-                break;
-            }
-                // currently in single quote
-            case 4: {
-                if (prevChar != '\\') {
-                    if (curChar == '\'')
-                        state = 6;
-                }
-                break;
-            }
-                // buffer state
-            case 5:
-            case 6: {
-                state = 7;
-                break;
-            }
-                // starting a string
-            case 8: {
-                if (prevChar == '\"') {
-                    if (curChar == '\"') {
-                        state = 1;
-                    } else {
-                        state = 3;
-                    }
-                    break;
-                } else if (prevChar == '\'') {
-                    if (curChar == '\'') {
-                        state = 1;
-                    } else {
-                        state = 4;
-                    }
-                    break;
-                } else if (prevChar == '[') {
-                    if (curChar == ']') {
-                        state = 1;
-                        break;
-                    } else {
-                        state = 13;
-                    }
-
-                }
-
-            }
-            // in bracket
-            case 13: {
-
-                if (curChar == ']') {
-                    state = 14;
-                }
-                break;
-            }
-            // boolean
-            case 9: {
-                state = 10;
-                break;
-            }
-            // reset to 0
-            default: {
-                state = 0;
-            }
-
-        }
+    // run the table driven lexer over the whole program (large programs are lexed on
+    // every core, the tokens are the same either way)
+    int errorLine = 0;
+    bool lexed;
+    if (source.size() >= PARALLEL_LEX_BYTES && threadPool::shared().size() > 1)
+        lexed = lexParallel(source, TB, errorLine);
+    else
+    {
+        lexer lex(source, TB);
+        lexed = lex.run();
+        errorLine = lex.lineNumber();
     }
 
-    if (state == 0)
+    if (!lexed)
     {
+        outFS  << "Syntax error on line " << errorLine << ": invalid integer\n";
+        delete TB;
+        return nullptr;
+    }
 
-        if (!isalpha(curChar) && !isdigit(curChar))
-        {
-            string convertedChar = convertChar(curChar), convertedNextIdx;
-            // this is only referenced if it is known that idx + 1 < size, it is placed above to avoid duplicate code
-            convertedNextIdx += cL[idx + 1];
-
-            if (beginningOfBoolean(convertedChar) || !checkToken(convertedChar).empty())
-            {
-
-
-                if (curChar == '[' || ((curChar == '\"' || curChar == '\'') && prevChar != '\\'))
-                {
-                    state = 8;
-                }
-                else if (curChar == '-')
-                {
-                    if (idx + 1 < cL.size())
-                    {
-                        if (isInt(convertedNextIdx))
-                            state = 0;
-                        else
-                            state = 1;
-                    }
-                    else
-                    {
-                        state = 1;
-                    }
-
-                }
-                else if (isBoolean(convertedChar)) {
-
-                    if (idx + 1 < cL.size() && isBoolean(convertedNextIdx))
-                    {
-                        state = 9;
-                    }
-                    else
-                    {
-                        state = 1;
-                    }
-                }
-                else if (curChar == ';' || !currentText.empty())
-                {
-                    state = 5;
-                }
-                else
-                {
-                    state = 1;
-                }
-
-            }
-            else if (curChar == ' ')
-            {
-                state = 2;
-            }
-
-        }
-        else if (isalpha(curChar) && idx == cL.size() - 1)
-        {
-            state = 11;
-        }
+    outFS.close();
+    TB->output(outputFile);
 
+    return TB;
+
+}
 
-    }
-    return state;
 
+/***
+ * This function creates a token stream over a program held in memory, nothing is
+ * lexed until the parser asks for a token and only a small window of tokens is kept
+ * (so the whole token list is never held at once). An invalid integer ends the stream
+ * and is reported in the output file when it is reached, check failed() after parsing
+ * @param source the program (without comments), it must outlive the stream
+ * @param outputFile the file that will hold the token output (or the error)
+ * @return the token stream
+ */
+tokenBuffer * createTokenStream(string_view source, const string& outputFile)
+{
+    auto * TB = new tokenBuffer(source);
+    TB->stream(new lexer(source, TB), outputFile);
+    return TB;
+}
+
+
+/***
+ * This function iterates through a program held in memory and creates a token
+ * list of its contents
+ * @param source the program (without comments)
+ * @param outputFile the file that will hold the eventual output if no errors
+ * are encountered
+ * @return a pointer to the head node of the token list, or null if the file is
+ * empty/an error is encountered
+ */
+tokenList * tokenizeSource(string_view source, const string& outputFile)
+{
+    tokenBuffer * TB = createTokenBuffer(source, outputFile);
+    if (!TB)
+        return nullptr;
 
+    tokenList * TL = TB->toList();
+    delete TB;
+    return TL;
 }
 
 
 /***
- * This function iterates through a program and creates a token list of
- * its contents
+ * This function reads a program from a file and creates a token list of
+ * its contents (thin wrapper around tokenizeSource)
  * @param inputFile the file that holds the program
  * @param outputFile the file that will hold the eventual output if no errors
  * are encountered
@@ -346,240 +253,21 @@ int state(int& state, const char& curChar, const char& prevChar, const string& c
 tokenList * createTokenList(const string& inputFile, const string& outputFile)
 {
     ifstream inFS;
-    ofstream outFS;
-    string curText, curLine, title, convertedChar;
-    int stateNum = 0, lineNum = 1, bracketCtr = 0, parenthesesCtr = 0;
-    char curChar, prevChar;
-    bool variableDeclaration, functionDeclaration, funcName;
-    // error flags
-    bool integerError = false;
-
-    auto * TL = new tokenList;
-    token *_token = nullptr;
-    bool startFunction = false, inFunction = false;
-    vector<string> variableNames;
+    stringstream buffer;
 
     inFS.open(inputFile);
-    outFS.open(outputFile);
-
 
-    // ensure the files opened correctly
-    if (!inFS.is_open() || !outFS.is_open())
+    // ensure the file opened correctly
+    if (!inFS.is_open())
     {
-        string file;
-        if (!inFS.is_open())
-            file = inputFile;
-        else
-            file = outputFile;
-        cout << "ERROR OPENING -> " << file << endl;
+        cout << "ERROR OPENING -> " << inputFile << endl;
         exit(1);
     }
 
-
-    while (getline(inFS, curLine)) {
-
-        // reset curText, state, and booleans
-        curText.clear(); // empty the string
-        stateNum = 0;
-
-        variableDeclaration = false;
-        functionDeclaration = false;
-        funcName = false;
-
-        for (int i = 0; i < curLine.size(); i++)
-        {
-            // get the current char and related state
-            curChar = curLine[i];
-            stateNum = state(stateNum, curChar, prevChar, curText, i, curLine);
-
-            switch (stateNum) {
-
-                // this is for special tokens (found in the const vector placed at the top)
-                case 1: case 7: case 8: case 10:
-                {
-                    if (stateNum == 8)
-                    {
-                        if (!curText.empty()) {
-                            _token = new token("IDENTIFIER", curText);
-                            TL->insert(_token);
-                        }
-                        curText.clear();
-                    }
-                    // if the current token is not a non-single char boolean (==, >=, etc)
-                    if (stateNum < 10)
-                    {
-                        convertedChar.clear();
-                    }
-                    else
-                    {
-                        convertedChar = curText;
-                    }
-
-                    convertedChar += curChar;
-                    _token = new token(checkToken(convertedChar), convertedChar);
-
-                    if (stateNum != 8)
-                    {
-                        stateNum = 0;
-                    }
-                    curText.clear(); // empty the string
-                    break;
-
-                }
-                // end of the line (for conditionals)
-                case 11:
-                {
-                    curText += curChar;
-                }
-                // non-special character token
-                case 2: case 5:
-                {
-                    // ensure that you have characters in curText
-                    if (!curText.empty())
-                    {
-                        string tokenTitle;
-                        // check if the curText is an integer (in a string)
-                        if (curText == "function" || curText == "procedure")
-                        {
-                            startFunction = true;
-                            if (curText == "function")
-                                functionDeclaration = true;
-                            TL->insert(_token);
-                        }
-                        else if (functionDeclaration)
-                        {
-                            if (isInt(curText))
-                            {
-                                integerError = true;
-                                goto intError;
-                            }
-                            functionDeclaration = false;
-                            variableDeclaration = true;
-                            funcName = true;
-
-                        }
-                        else if (!variableDeclaration && checkReserveWord(curText, VAR_RESERVED_WORDS))
-                        {
-                            variableDeclaration = true;
-                        }
-                        else if (variableDeclaration)
-                        {
-
-                            // check for invalid integer placement in an identifier
-                            if (isInt(curText))
-                            {
-                                integerError = true;
-                                goto intError;
-                            }
-                            if (!funcName)
-                                variableNames.push_back(curText);
-
-                            variableDeclaration = funcName =  false;
-
-                        }
-                        if (isInt(curText))
-                        {
-                            tokenTitle = "INTEGER";
-                        }
-                        // string is not entirely an integer, check if invalid integer placement in name
-                        else if (checkInvalidIntegerError(curText))
-                        {
-                            integerError = true;
-                            goto intError;
-                        }
-                        else
-                        {
-                            if (tokenTitle.empty())
-                                tokenTitle = "IDENTIFIER";
-                        }
-
-                        _token = new token(tokenTitle, curText);
-                        curText.clear(); // empty the string
-                    }
-                    // this is for the last token prior a semicolon or text in a parentheses for example
-                    if (stateNum == 5)
-                        i--;
-                    break;
-
-                }
-                // in a string (either double or single quote)
-                case 3: case 4:
-                {
-                    curText += curChar;
-                    break;
-                }
-                // end of string (decrement to get the last double/single quote)
-                case 6:
-                {
-                    _token = new token("STRING", curText);
-                    curText.clear(); // empty the string
-                    i--;
-                    break;
-                }
-                case 14:
-                {
-                    // array index is either a number or an identifier
-                    if (isInt(curText))
-                    {
-                        _token = new token("INTEGER", curText);
-                    }
-                    else
-                        _token = new token("IDENTIFIER", curText);
-                    curText.clear(); // empty the string
-
-                }
-                // add the char to curText if it is not a space
-                default:
-                {
-                    if (curChar != ' ')
-                        curText += curChar;
-                }
-
-            }
-
-            // if you have a token, add it to the list
-            if (_token)
-            {
-                TL->insert(_token);
-
-            }
-            prevChar = curChar;
-
-        }
-
-
-        if (startFunction && bracketCtr != 0)
-        {
-            inFunction = true;
-            startFunction = false;
-        }
-        else if (inFunction && bracketCtr == 0)
-        {
-            inFunction = false;
-        }
-
-
-        // current line is over
-        lineNum++;
-        _token = new token("endl", "");
-        TL->insert( _token);
-
-
-    }
+    buffer << inFS.rdbuf();
     inFS.close();
 
-    intError:
-    if (integerError)
-    {
-        outFS  << "Syntax error on line " << lineNum << ": invalid integer\n";
-        return nullptr;
-    }
-
-    outFS.close();
-    TL->output(outputFile);
-
-    return TL;
-
+    return tokenizeSource(buffer.str(), outputFile);
 }
 
 